@@ -38,13 +38,104 @@ This is a cut down version of the Adafruit GFX library for BlackSoC.
 #include <stdint.h>
 #include "font.h"
 
-static unsigned char buffer [1024];
-
 static const int16_t WIDTH = 128;
 static const int16_t HEIGHT = 128;
 
+// provided by the display driver
 void drawPixel(int16_t x, int16_t y, uint16_t color);
 
+// set the display's write window once, then stream the pixels of the
+// window in rows: writeColor() repeats a colour, writePixelPair() sends
+// two pixels in one store
+void setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+void writeColor(uint16_t color, uint32_t len);
+void writePixelPair(uint16_t first, uint16_t second);
+
+// Framebuffer: between fbBegin() and fbEnd() drawing goes to a 1 bit per
+// pixel copy of the display in RAM (leftmost pixel in bit 7), and the 16x16
+// tiles it touches are marked dirty. fbFlush() then sends only the dirty
+// tiles, each run of them along a tile row as one window, in the two
+// colours given to fbBegin().
+#define FB_TILE_SHIFT 4
+#define FB_ROW_BYTES 16
+
+static uint8_t fb[FB_ROW_BYTES * 128];
+static uint8_t fb_dirty[8];     // bit x of row y: tile (x, y)
+static uint8_t fb_enabled;
+static uint16_t fb_fg, fb_bg;
+
+static void fbPixel(int16_t x, int16_t y, uint16_t color) {
+    if((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT)) return;
+    uint8_t *p = &fb[(y << 4) + (x >> 3)];
+    uint8_t bit = 0x80 >> (x & 7);
+    if (color) *p |= bit;
+    else *p &= ~bit;
+    fb_dirty[y >> FB_TILE_SHIFT] |= 1 << (x >> FB_TILE_SHIFT);
+}
+
+// drawing one pixel, to the framebuffer or the display
+static void plot(int16_t x, int16_t y, uint16_t color) {
+    if (fb_enabled) fbPixel(x, y, color);
+    else drawPixel(x, y, color);
+}
+
+// pixels of differing colours are paired up for writePixelPair()
+static uint16_t held_color;
+static uint8_t held;
+
+// in framebuffer mode a window is filled in the buffer instead
+static int16_t win_x, win_w, win_cx, win_cy;
+
+static void beginWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (fb_enabled) {
+        win_x = win_cx = x;
+        win_cy = y;
+        win_w = w;
+    } else {
+        setAddrWindow(x, y, w, h);
+    }
+}
+
+static void streamPixel(uint16_t color) {
+    if (fb_enabled) {
+        fbPixel(win_cx, win_cy, color);
+        if (++win_cx == win_x + win_w) {
+            win_cx = win_x;
+            win_cy++;
+        }
+        return;
+    }
+    if (held) {
+        writePixelPair(held_color, color);
+        held = 0;
+    } else {
+        held_color = color;
+        held = 1;
+    }
+}
+
+static void streamEnd() {
+    if (held) writeColor(held_color, 1);
+    held = 0;
+}
+
+static void streamColor(uint16_t color, uint32_t len) {
+    if (fb_enabled) {
+        for (; len; len--) streamPixel(color);
+    } else {
+        writeColor(color, len);
+    }
+}
+
+// clip a rectangle to the display, returns 0 if nothing is left
+static int clipRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) {
+    if (*x < 0) { *w += *x; *x = 0; }
+    if (*y < 0) { *h += *y; *y = 0; }
+    if (*x + *w > WIDTH) *w = WIDTH - *x;
+    if (*y + *h > HEIGHT) *h = HEIGHT - *y;
+    return *w > 0 && *h > 0;
+}
+
 #define _swap_int16_t(a, b) { int16_t t = a; a = b; b = t; }
 
 // Lines
@@ -77,9 +168,9 @@ void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 
     for (; x0<=x1; x0++) {
         if (steep) {
-            drawPixel(y0, x0, color);
+            plot(y0, x0, color);
         } else {
-            drawPixel(x0, y0, color);
+            plot(x0, y0, color);
         }
         err -= dy;
         if (err < 0) {
@@ -89,31 +180,32 @@ void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     }
 }
 
+void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+        uint16_t color) {
+    if (!clipRect(&x, &y, &w, &h)) return;
+    beginWindow(x, y, w, h);
+    // a row at a time, as there is no multiply
+    for (int16_t j = 0; j < h; j++) streamColor(color, w);
+}
+
 void drawFastVLine(int16_t x, int16_t y,
         int16_t h, uint16_t color) {
-    drawLine(x, y, x, y+h-1, color);
+    fillRect(x, y, 1, h, color);
 }
 
 void drawFastHLine(int16_t x, int16_t y,
         int16_t w, uint16_t color) {
-    drawLine(x, y, x+w-1, y, color);
+    fillRect(x, y, w, 1, color);
 }
 
 // Rectangles
 
 void drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
         uint16_t color) {
-    drawLine(x, y, x+w-1, y, color);
-    drawLine(x, y+h-1, x+w-1, y+h-1, color);
-    drawLine(x, y, x, y+h-1, color);
-    drawLine(x+w-1, y, x+w-1, y+h-1, color);
-}
-
-void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
-        uint16_t color) {
-    for (int16_t i=x; i<x+w; i++) {
-        drawFastVLine(i, y, h, color);
-    }
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y+h-1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x+w-1, y, h, color);
 }
 
 void fillScreen(uint16_t color) {
@@ -129,7 +221,8 @@ void drawTriangle(int16_t x0, int16_t y0,
     drawLine(x2, y2, x0, y0, color);
 }
 
-void fillTriangle(int16_t x0, int16_t y0,
+// static so it is only linked in when used, it needs multiply and divide
+static void fillTriangle(int16_t x0, int16_t y0,
         int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
 
     int16_t a, b, y, last;
@@ -216,10 +309,10 @@ void drawCircle(int16_t x0, int16_t y0, int16_t r,
     int16_t x = 0;
     int16_t y = r;
 
-    drawPixel(x0  , y0+r, color);
-    drawPixel(x0  , y0-r, color);
-    drawPixel(x0+r, y0  , color);
-    drawPixel(x0-r, y0  , color);
+    plot(x0  , y0+r, color);
+    plot(x0  , y0-r, color);
+    plot(x0+r, y0  , color);
+    plot(x0-r, y0  , color);
 
     while (x<y) {
         if (f >= 0) {
@@ -231,14 +324,14 @@ void drawCircle(int16_t x0, int16_t y0, int16_t r,
         ddF_x += 2;
         f += ddF_x;
 
-        drawPixel(x0 + x, y0 + y, color);
-        drawPixel(x0 - x, y0 + y, color);
-        drawPixel(x0 + x, y0 - y, color);
-        drawPixel(x0 - x, y0 - y, color);
-        drawPixel(x0 + y, y0 + x, color);
-        drawPixel(x0 - y, y0 + x, color);
-        drawPixel(x0 + y, y0 - x, color);
-        drawPixel(x0 - y, y0 - x, color);
+        plot(x0 + x, y0 + y, color);
+        plot(x0 - x, y0 + y, color);
+        plot(x0 + x, y0 - y, color);
+        plot(x0 - x, y0 - y, color);
+        plot(x0 + y, y0 + x, color);
+        plot(x0 - y, y0 + x, color);
+        plot(x0 + y, y0 - x, color);
+        plot(x0 - y, y0 - x, color);
     }
 }
 
@@ -286,13 +379,22 @@ void drawBitmap(int16_t x, int16_t y,
     int16_t byteWidth = (w + 7) / 8; 
     uint8_t byte = 0;
 
-    for(int16_t j=0; j<h; j++, y++) {
-        for(int16_t i=0; i<w; i++ ) {
-            if(i & 7) byte >>= 1;
-            else      byte   = bitmap[j * byteWidth + i / 8];
-            drawPixel(x+i, y, (byte & 0x80));
+    // the window takes every pixel, so clear bits are drawn black
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    if (!clipRect(&cx, &cy, &cw, &ch)) return;
+    beginWindow(cx, cy, cw, ch);
+
+    const uint8_t *row = bitmap;
+    for(int16_t j=0; j<cy-y; j++) row += byteWidth;
+
+    for(int16_t j=0; j<ch; j++, row += byteWidth) {
+        for(int16_t i=0; i<cx-x+cw; i++ ) {
+            if(i & 7) byte <<= 1;
+            else      byte   = row[i / 8];
+            if (i >= cx-x) streamPixel((byte & 0x80) ? color : 0);
         }
     }
+    streamEnd();
 }
 
 // Text 
@@ -300,27 +402,64 @@ void drawBitmap(int16_t x, int16_t y,
 void drawChar(int16_t x, int16_t y, unsigned char c,
   uint16_t color) {
 
-    if((x >= WIDTH)            || // Clip right
-       (y >= HEIGHT)           || // Clip bottom
-       ((x + 6 - 1) < 0) || // Clip left
-       ((y + 8 - 1) < 0))   // Clip top
-        return;
+    int16_t cx = x, cy = y, cw = 5, ch = 8;
+    if (!clipRect(&cx, &cy, &cw, &ch)) return;
 
-    for(int8_t i=0; i<5; i++ ) { // Char bitmap = 5 columns
-        uint8_t line = font[c * 5 + i];
-        for(int8_t j=0; j<8; j++, line >>= 1) {
-            if(line & 1) {
-                drawPixel(x+i, y+j, color);
-            } else {
-                drawPixel(x+i, y+j, 0);
-            }
+    // the font is in columns, the window is filled in rows
+    const unsigned char *glyph = &font[(c << 2) + c];
+    beginWindow(cx, cy, cw, ch);
+    for(int8_t j=cy-y; j<cy-y+ch; j++) {
+        for(int8_t i=cx-x; i<cx-x+cw; i++) {
+            streamPixel((glyph[i] >> j) & 1 ? color : 0);
         }
     }
+    streamEnd();
 }
 
 void drawText(int16_t x, int16_t y, const char *text, int16_t c) {
-    for(int i=0;text[i];i++) {
-        drawChar(x + i*6,y,text[i],c);
+    for(int i=0;text[i];i++, x += 6) {
+        drawChar(x,y,text[i],c);
     }
 }
 
+// Framebuffer
+
+void fbBegin(uint16_t fg, uint16_t bg) {
+    for (int i = 0; i < FB_ROW_BYTES * 128; i++) fb[i] = 0;
+    for (int i = 0; i < 8; i++) fb_dirty[i] = 0xff;
+    fb_fg = fg;
+    fb_bg = bg;
+    fb_enabled = 1;
+}
+
+void fbEnd() {
+    fb_enabled = 0;
+}
+
+void fbFlush() {
+    for (int16_t ty = 0; ty < 8; ty++) {
+        uint8_t dirty = fb_dirty[ty];
+        fb_dirty[ty] = 0;
+        int16_t tx = 0;
+        while (dirty) {
+            // a run of dirty tiles is one window
+            while (!(dirty & 1)) { dirty >>= 1; tx++; }
+            int16_t run = 0;
+            while (dirty & 1) { dirty >>= 1; run++; }
+
+            int16_t y = ty << FB_TILE_SHIFT;
+            setAddrWindow(tx << FB_TILE_SHIFT, y, run << FB_TILE_SHIFT, 1 << FB_TILE_SHIFT);
+            for (int16_t j = 0; j < (1 << FB_TILE_SHIFT); j++) {
+                const uint8_t *p = &fb[((y + j) << 4) + (tx << 1)];
+                for (int16_t b = 0; b < (run << 1); b++) {
+                    uint8_t byte = p[b];
+                    for (int k = 0; k < 4; k++, byte <<= 2) {
+                        writePixelPair(byte & 0x80 ? fb_fg : fb_bg,
+                                       byte & 0x40 ? fb_fg : fb_bg);
+                    }
+                }
+            }
+            tx += run;
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <uart/uart.h>
+#include "gfx.h"
 
 // a pointer to this is a null pointer, but the compiler does not
 // know that because "sram" is a linker symbol from sections.lds.
@@ -16,9 +17,14 @@ extern uint32_t sram;
 #define reg_xfer (*(volatile uint32_t*)0x05000008)
 #define reg_prescale (*(volatile uint32_t*)0x05000000)
 #define reg_mode (*(volatile uint32_t*)0x0500000c)
+#define reg_tx_data4 (*(volatile uint32_t*)0x05000020)
+#define reg_tx_cmd (*(volatile uint32_t*)0x05000024)
+#define reg_tx_data (*(volatile uint32_t*)0x05000028)
+#define reg_tx_pixels (*(volatile uint32_t*)0x0500002c)
+#define reg_tx_status (*(volatile uint32_t*)0x05000030)
+#define reg_tx_irq (*(volatile uint32_t*)0x05000034)
 
-#define WIDTH 128
-#define HEIGHT 128
+#define TX_BUSY 0x100
 
 uint32_t set_irq_mask(uint32_t mask); asm (
     ".global set_irq_mask\n"
@@ -29,22 +35,18 @@ uint32_t set_irq_mask(uint32_t mask); asm (
 
 void irq_handler(uint32_t irqs, uint32_t* regs) { }
 
+// the tx fifo tags each byte with DC and frames CS itself, a store only
+// waits if the fifo is full
 void send_cmd(uint8_t r) {
-	reg_cs = 1;
-	reg_dc = 0;
-	reg_cs = 0;
-
-	reg_xfer = r;
-	reg_cs = 1;
+	reg_tx_cmd = r;
 }
 
 void send_data(uint8_t d) {
-	reg_cs = 1;
-	reg_dc = 1;
-	reg_cs = 0;
+	reg_tx_data = d;
+}
 
-	reg_xfer = d;
-	reg_cs = 1;
+void wait_tx() {
+	while (reg_tx_status & TX_BUSY);
 }
 
 void reset() {
@@ -55,23 +57,78 @@ void reset() {
 	reg_rst = 1;;
 }
 
-void drawPixel(int16_t x, int16_t y, uint16_t color) {
-        if((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT)) return;
-	
+// column and row window, then write RAM: the pixels that follow fill
+// the window a row at a time
+void setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
 	send_cmd(0x15);
 	send_data(x);
-	send_data(WIDTH-1);
+	send_data(x+w-1);
 
 	send_cmd(0x75);
 	send_data(y);
-	send_data(HEIGHT-1);
+	send_data(y+h-1);
 
 	send_cmd(0x5C);
+}
+
+void writeColor(uint16_t color, uint32_t len) {
+	uint32_t pair = ((uint32_t) color << 16) | color;
+	for (; len >= 2; len -= 2) reg_tx_pixels = pair;
+	if (len) {
+		send_data(color >> 8);
+		send_data(color);
+	}
+}
+
+void writePixelPair(uint16_t first, uint16_t second) {
+	reg_tx_pixels = ((uint32_t) first << 16) | second;
+}
+
+void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT)) return;
 
+	setAddrWindow(x, y, 1, 1);
 	send_data(color >> 8);
 	send_data(color);
 }
 
+static uint32_t rdcycle() {
+	uint32_t cycles;
+	asm volatile ("rdcycle %0" : "=r"(cycles));
+	return cycles;
+}
+
+static uint32_t bench_start;
+
+static void bench_begin() {
+	wait_tx();
+	bench_start = rdcycle();
+}
+
+// cycles until the last byte has left the SPI shifter
+static void bench_end(const char *name) {
+	wait_tx();
+	uint32_t cycles = rdcycle() - bench_start;
+	print(name);
+	print(": ");
+	print_hex(cycles, 8);
+	print(" cycles\n");
+}
+
+void benchmark() {
+	bench_begin(); drawPixel(10, 10, 0xffff); bench_end("drawPixel");
+	bench_begin(); drawFastHLine(0, 20, 128, 0xf800); bench_end("drawFastHLine 128");
+	bench_begin(); drawFastVLine(20, 0, 128, 0x07e0); bench_end("drawFastVLine 128");
+	bench_begin(); drawRect(10, 10, 100, 100, 0x001f); bench_end("drawRect 100x100");
+	bench_begin(); fillRect(20, 20, 64, 64, 0xffe0); bench_end("fillRect 64x64");
+	bench_begin(); fillScreen(0); bench_end("fillScreen");
+	bench_begin(); drawChar(0, 0, 'A', 0xffff); bench_end("drawChar");
+	bench_begin(); drawText(0, 0, "Hello world", 0xffff); bench_end("drawText 11");
+	bench_begin(); drawBitmap(0, 64, font, 40, 8, 0x07ff); bench_end("drawBitmap 40x8");
+	bench_begin(); drawLine(0, 0, 127, 127, 0xf81f); bench_end("drawLine 128");
+	bench_begin(); fillCircle(64, 64, 30, 0x7bef); bench_end("fillCircle r30");
+}
+
 void main() {
     reg_uart_clkdiv = 139;
 
@@ -85,7 +142,7 @@ void main() {
     /*print("Initialising\n");      
     reg_cs = 1;
     reg_rst = 1;
-    reg_prescale = 4; // 4Mhz
+    reg_prescale = 0; // 8Mhz
     reg_mode = 0;
     print("Reset\n");
     send_cmd(0xFD); // Command lock
@@ -134,6 +191,8 @@ void main() {
 
     print("Initialisation done\n");*/
 
+    benchmark();
+
     int x = 0;
     while (1) {
         timer = timer + 1;
@@ -5,6 +5,7 @@
 #include <video/video.h>
 #include <songplayer/songplayer.h>
 #include <uart/uart.h>
+#include <dma/dma.h>
 #include <sine_table/sine_table.h>
 
 #include "graphics_data.h"
@@ -35,6 +36,8 @@ extern const struct song_t song_pacman;
 
 #define ZERO_TILE 16
 
+#define GHOST_IMAGE 2
+
 #define U_TILE 26
 #define P_TILE 27
 
@@ -47,11 +50,9 @@ const uint8_t clyde = 4;
 uint32_t counter_frequency = 16000000/50;  /* 50 times per second */
 uint32_t led_state = 0x00000000;
 
-uint8_t board[14][15];
 uint8_t pac_image, pac_x, pac_y;
 uint8_t inky_x, blinky_x, pinky_x, clyde_x;
 uint8_t inky_y, blinky_y, pinky_y, clyde_y;
-uint8_t ghost_up;
 uint16_t score;
 
 uint32_t set_irq_mask(uint32_t mask); asm (
@@ -68,46 +69,44 @@ uint32_t set_timer_counter(uint32_t val); asm (
     "ret\n"
 );
 
-void set_up_board() {
-  for(int y = 0; y < 14; y++) {
-    for(int x = 0;  x < 15; x++) {
-      uint8_t n = 0;
-      uint8_t t = tile_data[((y*2 + 1) << 5) + x*2 + 1];
+// the maze comes from tile_data in flash and the food still to eat is
+// whatever the tile map shows, so the board has no copy in RAM
+uint32_t board_cell(int x, int y) {
+  uint32_t n = 0;
+  uint8_t t = tile_data[((y*2 + 1) << 5) + x*2 + 1];
 
-      if (t != BLANK_TILE && t != FOOD_TILE1) continue;
+  if (t != BLANK_TILE && t != FOOD_TILE1) return 0;
 
-      if (t == FOOD_TILE1) n |= FOOD;
+  if (vid_get_tile(x*2 + 1, y*2 + 1) == FOOD_TILE1) n |= FOOD;
 
-      if (y > 0) {
-        uint8_t above = tile_data[(((y-1)*2 + 2) << 5) + x*2 + 1];
-        if (above == BLANK_TILE || above == FOOD_TILE3) n |= CAN_GO_UP;
-      }
+  if (y > 0) {
+    uint8_t above = tile_data[(((y-1)*2 + 2) << 5) + x*2 + 1];
+    if (above == BLANK_TILE || above == FOOD_TILE3) n |= CAN_GO_UP;
+  }
 
-      if (y < 13) {
-        uint8_t below = tile_data[(((y+1)*2 + 1) << 5) + x*2 + 1];
-        if (below == BLANK_TILE || below == FOOD_TILE1) n |= CAN_GO_DOWN;
-      }
+  if (y < 13) {
+    uint8_t below = tile_data[(((y+1)*2 + 1) << 5) + x*2 + 1];
+    if (below == BLANK_TILE || below == FOOD_TILE1) n |= CAN_GO_DOWN;
+  }
 
-      if (x > 0) {
-        uint8_t left = tile_data[((y*2 + 1) << 5) + (x-1)*2 + 2];
-        if (left == BLANK_TILE || left == FOOD_TILE2) n |= CAN_GO_LEFT;
-      }
+  if (x > 0) {
+    uint8_t left = tile_data[((y*2 + 1) << 5) + (x-1)*2 + 2];
+    if (left == BLANK_TILE || left == FOOD_TILE2) n |= CAN_GO_LEFT;
+  }
 
-      if (x < 14) {
-        uint8_t right = tile_data[((y*2 + 1) << 5) + (x+1)*2 + 1];
-        if (right == BLANK_TILE || right == FOOD_TILE1) n |= CAN_GO_RIGHT;
-      }
+  if (x < 14) {
+    uint8_t right = tile_data[((y*2 + 1) << 5) + (x+1)*2 + 1];
+    if (right == BLANK_TILE || right == FOOD_TILE1) n |= CAN_GO_RIGHT;
+  }
 
-      board[y][x] = n;
-    }
-  }      
+  return n;
 }
 
 void print_board() {
   print("Board:\n");
   for(int y = 0; y < 14; y++) {
     for(int x = 0; x < 15; x++) {
-      print_hex(board[y][x],2);
+      print_hex(board_cell(x, y),2);
       print(" ");
     }
     print("\n");
@@ -118,26 +117,23 @@ void setup_screen() {
   vid_init();
   vid_set_x_ofs(0);
   vid_set_y_ofs(0);
-  int tex,x,y;
-
-  for (tex = 0; tex < 64; tex++) {
-    for (x = 0; x < 8; x++) {
-      for (y = 0 ; y < 8; y++) {
-        int texrow = tex >> 3;   // 0-7, row in texture map
-        int texcol = tex & 0x07; // 0-7, column in texture map
-        int pixx = (texcol<<3)+x;
-        int pixy = (texrow<<3)+y;
-        uint32_t pixel = texture_data[(pixy<<6)+pixx];
-        vid_set_texture_pixel(tex, x, y, pixel);
-      }
-    }
-  }
 
-  for (x = 0; x < 32; x++) {
-    for (y = 0; y < 32; y++) {
-      vid_set_tile(x,y,tile_data[(y<<5)+x]);
-    }
+  // the maze is built in the hidden tile page, then shown in one go
+  vid_set_page_mode(1);
+  vid_set_draw_page(1);
+  // the textures are packed already, so the dma controller copies them
+  // straight from flash while the cpu builds the tile map
+  dma_start(texture_words, reg_video_texmem_packed, 512, 4, 4, 0);
+  vid_upload_tilemap(tile_data, 32, 32);
+  dma_wait();
+  vid_show_page(1);
+
+  // the score panel right of the maze is a window, so it stays put if the
+  // maze scrolls
+  for (int y = 0; y < 30; y++) {
+    vid_fill_window_row(0, y, 8, BLANK_TILE);
   }
+  vid_set_window(256, 0, VID_WINDOW_ENABLE | VID_WINDOW_PRIORITY);
 
   pac_image = 0;
 
@@ -153,6 +149,14 @@ void setup_screen() {
   clyde_y = 9;
 
   vid_write_sprite_memory(pac_image, sprites[pacman]);
+
+  // the ghosts bob by animating between two images, the second one raised
+  uint32_t raised[16];
+  for (int y = 0; y < 16; y++) {
+    raised[y] = (y < 14) ? sprites[pacman][y + 2] : 0;
+  }
+  vid_write_sprite_memory(GHOST_IMAGE, sprites[pacman]);
+  vid_write_sprite_memory(GHOST_IMAGE + 1, raised);
   
   vid_set_sprite_pos(pacman, 8 + (pac_x << 4), 8 + (pac_y << 4));
   vid_set_sprite_pos(inky, 8 + (inky_x << 4), 8 + (inky_y << 4));
@@ -167,10 +171,15 @@ void setup_screen() {
   vid_set_sprite_colour(clyde, 1);
 
   vid_set_image_for_sprite(pacman, pac_image);
-  vid_set_image_for_sprite(inky, pac_image);
-  vid_set_image_for_sprite(pinky, pac_image);
-  vid_set_image_for_sprite(blinky, pac_image);
-  vid_set_image_for_sprite(clyde, pac_image);
+  vid_set_image_for_sprite(inky, GHOST_IMAGE);
+  vid_set_image_for_sprite(pinky, GHOST_IMAGE);
+  vid_set_image_for_sprite(blinky, GHOST_IMAGE);
+  vid_set_image_for_sprite(clyde, GHOST_IMAGE);
+
+  vid_set_sprite_anim(inky, 2, 8);
+  vid_set_sprite_anim(pinky, 2, 8);
+  vid_set_sprite_anim(blinky, 2, 8);
+  vid_set_sprite_anim(clyde, 2, 8);
 
   vid_enable_sprite(pacman, 1);
   vid_enable_sprite(inky, 1);
@@ -186,9 +195,9 @@ void irq_handler(uint32_t irqs, uint32_t* regs)
     // print_str("[EXT-IRQ-4]");
   }
 
-  /* slow IRQ (5) */
+  /* video IRQ (5) */
   if ((irqs & (1<<5)) != 0) {
-    // print_str("[EXT-IRQ-5]");
+    vid_ack_irq();
   }
 
   /* timer IRQ */
@@ -208,6 +217,7 @@ const int divisor[] = {10000,1000,100,10};
 void show_score() {
   int s = score;
   bool blank = true;
+  uint8_t tiles[5];
 
   for(int i=0; i<5; i++) {
     int d = 0;
@@ -222,9 +232,9 @@ void show_score() {
       s += div;
       if (d !=0) blank = false;
     }
-    int tile = blank && i != 4 ? BLANK_TILE : ZERO_TILE + d;
-    vid_set_tile(34+i, 8, tile);
+    tiles[i] = blank && i != 4 ? BLANK_TILE : ZERO_TILE + d;
   }
+  vid_copy_window_row(2, 8, 5, tiles);
 }
 
 void main() {
@@ -235,7 +245,6 @@ void main() {
 
     setup_screen();
     
-    set_up_board();
     print_board();
 
     songplayer_init(&song_pacman);
@@ -254,49 +263,40 @@ void main() {
     int old_x = 255, old_y = 255, old2_x = 255, old2_y = 255;
     score = 0;
 
-    vid_set_tile(32, 7, ZERO_TILE + 1);
-    vid_set_tile(33, 7, U_TILE);
-    vid_set_tile(34, 7, P_TILE);
+    const uint8_t one_up[] = { ZERO_TILE + 1, U_TILE, P_TILE };
+    vid_copy_window_row(0, 7, 3, one_up);
+
+    vid_enable_irq(VID_IRQ_VBLANK);
 
-    uint32_t time_waster = 0;
+    uint32_t frame = 0;
     while (1) {
-        time_waster = time_waster + 1;
-        if ((time_waster & 0xffff) == 0xffff) {
+        vid_wait_vblank();
+        frame = frame + 1;
+        if ((frame & 7) == 0) {
           show_score();
 
           /* update sprite locations */
 
-          int n = board[pac_y][pac_x];
+          int n = board_cell(pac_x, pac_y);
           if ((n & CAN_GO_UP) && (pac_y-1 != old2_y)) pac_y--;
           else if ((n & CAN_GO_RIGHT) && (pac_x+1 != old2_x)) pac_x++;
           else if ((n & CAN_GO_DOWN) && (pac_y+1 != old2_y)) pac_y++;
           else if ((n & CAN_GO_LEFT) && (pac_x-1 == old2_x)) pac_x--;
           
           vid_set_sprite_pos(pacman, 8 + (pac_x << 4), 8 + (pac_y << 4));
+          if (pac_x != old_x) vid_set_sprite_flip(pacman, pac_x < old_x, 0);
 
-	  if (n & FOOD) {
-            vid_set_tile(pac_x*2 + 1, pac_y*2 + 1, BLANK_TILE);
-            vid_set_tile(pac_x*2 + 2, pac_y*2 + 1, BLANK_TILE);
-            vid_set_tile(pac_x*2 + 1, pac_y*2 + 2, BLANK_TILE);
-            vid_set_tile(pac_x*2 + 2, pac_y*2 + 2, BLANK_TILE);
+	  // eat the food in the cell just moved to; blanking its tiles is
+	  // what clears it from the board
+	  if (board_cell(pac_x, pac_y) & FOOD) {
+            vid_fill_tile_rect(pac_x*2 + 1, pac_y*2 + 1, 2, 2, BLANK_TILE);
             score += 10;
-            board[pac_y][pac_x] & ~FOOD;
           }    
           
           old2_x = old_x;
           old2_y = old_y;
           old_x = pac_x;
           old_y = pac_y;
-      
-          ghost_up ^= 1;
-	  vid_set_sprite_pos(inky, TILE_SIZE + (inky_x << 4), 
-                                   TILE_SIZE + ((inky_y - ghost_up) << 4));
-	  vid_set_sprite_pos(pinky, TILE_SIZE + (pinky_x << 4), 
-                                   TILE_SIZE + ((pinky_y - ghost_up) << 4));
-	  vid_set_sprite_pos(blinky, TILE_SIZE + (blinky_x << 4), 
-                                   TILE_SIZE + ((blinky_y - ghost_up) << 4));
-	  vid_set_sprite_pos(clyde, TILE_SIZE + (clyde_x << 4), 
-                                   TILE_SIZE + ((clyde_y - ghost_up) << 4));
         }
     }
 }
@@ -79,17 +79,22 @@ module top (
 	wire [31:0] iomem_wdata;
 	wire [31:0] iomem_rdata;
 
-	// until we get gpio/i2c reading happening, nothing is read from iomem
-	wire iomem_ready = 1'b1;
-
-	// assign to i2c/gpio input when needed
-	assign iomem_rdata =  32'h 0000_0000;
-
 
 	// enable signals for each of the peripherals
 	wire led_en   = (iomem_addr[31:24] == 8'h03);  /* LED mapped to 0x03xx_xxxx */
 	wire audio_en = (iomem_addr[31:24] == 8'h04); /* Audio device mapped to 0x04xx_xxxx */
 	wire video_en = (iomem_addr[31:24] == 8'h05); /* Video device mapped to 0x05xx_xxxx */
+	wire dma_en   = (iomem_addr[31:24] == 8'h08); /* DMA controller mapped to 0x08xx_xxxx */
+
+	// only the video and dma devices are readable so far
+	wire [31:0] video_rdata;
+	wire [31:0] dma_rdata;
+	assign iomem_rdata = video_en ? video_rdata : dma_en ? dma_rdata : 32'h 0000_0000;
+
+	// the other peripherals answer in a single cycle, video memory reads
+	// can take longer
+	wire video_ready;
+	wire iomem_ready = video_en ? video_ready : 1'b1;
 
 	//////////////////////////////////////////
 	// LED
@@ -126,6 +131,7 @@ module top (
 	// VIDEO
 	//////////////////////////////////////////
 
+	wire video_irq;
 	video video_peripheral(
 		.clk(CLK),
 		.resetn(resetn),
@@ -133,6 +139,9 @@ module top (
 		.iomem_wstrb(iomem_wstrb),
 		.iomem_addr(iomem_addr),
 		.iomem_wdata(iomem_wdata),
+		.iomem_rdata(video_rdata),
+		.iomem_ready(video_ready),
+		.irq(video_irq),
 		.vga_hsync(VGA_HSYNC),
 		.vga_vsync(VGA_VSYNC),
 		.vga_r(VGA_R),
@@ -141,6 +150,35 @@ module top (
 	);
 
 
+	//////////////////////////////////////////
+	// DMA
+	//////////////////////////////////////////
+
+	wire dma_irq;
+	wire        dma_mem_valid;
+	wire        dma_mem_ready;
+	wire [3:0]  dma_mem_wstrb;
+	wire [31:0] dma_mem_addr;
+	wire [31:0] dma_mem_wdata;
+	wire [31:0] dma_mem_rdata;
+	dma dma_peripheral(
+		.clk(CLK),
+		.resetn(resetn),
+		.iomem_valid(iomem_valid && dma_en),
+		.iomem_wstrb(iomem_wstrb),
+		.iomem_addr(iomem_addr),
+		.iomem_wdata(iomem_wdata),
+		.iomem_rdata(dma_rdata),
+		.irq(dma_irq),
+		.mem_valid(dma_mem_valid),
+		.mem_ready(dma_mem_ready),
+		.mem_wstrb(dma_mem_wstrb),
+		.mem_addr(dma_mem_addr),
+		.mem_wdata(dma_mem_wdata),
+		.mem_rdata(dma_mem_rdata)
+	);
+
+
 	picosoc #(
 		.BARREL_SHIFTER(0),
 		.ENABLE_MULDIV(0),
@@ -178,8 +216,8 @@ module top (
 		.flash_io2_di (flash_io2_di),
 		.flash_io3_di (flash_io3_di),
 
-		.irq_5        (1'b0),
-		.irq_6        (1'b0        ),
+		.irq_5        (video_irq   ),
+		.irq_6        (dma_irq     ),
 		.irq_7        (1'b0        ),
 
 		.iomem_valid  (iomem_valid ),
@@ -187,7 +225,14 @@ module top (
 		.iomem_wstrb  (iomem_wstrb ),
 		.iomem_addr   (iomem_addr  ),
 		.iomem_wdata  (iomem_wdata ),
-		.iomem_rdata  (iomem_rdata )
+		.iomem_rdata  (iomem_rdata ),
+
+		.dma_valid    (dma_mem_valid),
+		.dma_ready    (dma_mem_ready),
+		.dma_wstrb    (dma_mem_wstrb),
+		.dma_addr     (dma_mem_addr ),
+		.dma_wdata    (dma_mem_wdata),
+		.dma_rdata    (dma_mem_rdata)
 	);
 
 endmodule
@@ -0,0 +1,126 @@
+/*
+ * IO mapped DMA controller for PicoSOC
+ *
+ * Copies words from anywhere on the memory bus (SPI flash, SRAM) to anywhere
+ * else (video memories, audio registers, SRAM).  It is a second bus master in
+ * picosoc.v, which hands the bus to the CPU and the DMA controller in turn, so
+ * the CPU keeps running while a transfer is in progress.
+ *
+ * registers (0x0800_0000 onwards)
+ * 0: source address
+ * 1: destination address
+ * 2: number of words to copy
+ * 3: address increments - 31-16: destination, 15-0: source (in bytes)
+ * 4: control/status
+ *      write - 0: start, 1: irq enable, 2: acknowledge irq (write 1)
+ *      read  - 0: busy, 1: irq enable, 2: done
+ */
+module dma
+(
+  input resetn,
+  input clk,
+	input iomem_valid,
+	input [3:0]  iomem_wstrb,
+	input [31:0] iomem_addr,
+	input [31:0] iomem_wdata,
+	output reg [31:0] iomem_rdata,
+  output irq,
+
+  // bus master port
+  output mem_valid,
+  input mem_ready,
+  output [3:0] mem_wstrb,
+  output [31:0] mem_addr,
+  output [31:0] mem_wdata,
+  input [31:0] mem_rdata);
+
+  localparam STATE_IDLE = 2'd0;
+  localparam STATE_READ = 2'd1;
+  localparam STATE_WRITE = 2'd2;
+
+  reg [1:0] state;
+  reg [31:0] src_addr;
+  reg [31:0] dst_addr;
+  reg [15:0] count;
+  reg [15:0] src_inc;
+  reg [15:0] dst_inc;
+  reg [31:0] data;
+  reg irq_enable;
+  reg done;
+
+  wire [2:0] reg_addr = iomem_addr[4:2];
+  wire reg_write = iomem_valid && iomem_wstrb[0];
+  wire busy = (state != STATE_IDLE);
+
+  assign irq = done && irq_enable;
+
+  assign mem_valid = busy;
+  assign mem_wstrb = (state == STATE_WRITE) ? 4'hf : 4'h0;
+  assign mem_addr = (state == STATE_WRITE) ? dst_addr : src_addr;
+  assign mem_wdata = data;
+
+  always @(posedge clk) begin
+    if (!resetn) begin
+      state <= STATE_IDLE;
+      count <= 0;
+      src_inc <= 4;
+      dst_inc <= 4;
+      irq_enable <= 0;
+      done <= 0;
+    end else begin
+      // registers can only be changed while idle
+      if (reg_write && !busy) begin
+        case (reg_addr)
+          3'h0: src_addr <= iomem_wdata;
+          3'h1: dst_addr <= iomem_wdata;
+          3'h2: count <= iomem_wdata[15:0];
+          3'h3: begin
+            src_inc <= iomem_wdata[15:0];
+            dst_inc <= iomem_wdata[31:16];
+          end
+          3'h4: begin
+            irq_enable <= iomem_wdata[1];
+            if (iomem_wdata[0] && count != 0) begin
+              state <= STATE_READ;
+              done <= 0;
+            end
+          end
+        endcase
+      end
+      if (reg_write && reg_addr == 3'h4 && iomem_wdata[2]) done <= 0;
+
+      case (state)
+        STATE_READ: begin
+          if (mem_ready) begin
+            data <= mem_rdata;
+            state <= STATE_WRITE;
+          end
+        end
+        STATE_WRITE: begin
+          if (mem_ready) begin
+            src_addr <= src_addr + src_inc;
+            dst_addr <= dst_addr + dst_inc;
+            count <= count - 1;
+            if (count == 1) begin
+              state <= STATE_IDLE;
+              done <= 1;
+            end else
+              state <= STATE_READ;
+          end
+        end
+      endcase
+    end
+  end
+
+  always @(*) begin
+    case (reg_addr)
+      3'h0: iomem_rdata = src_addr;
+      3'h1: iomem_rdata = dst_addr;
+      3'h2: iomem_rdata = count;
+      3'h3: iomem_rdata = { dst_inc, src_inc };
+      3'h4: iomem_rdata = { done, irq_enable, busy };
+      default: iomem_rdata = 32'h0;
+    endcase
+  end
+
+endmodule
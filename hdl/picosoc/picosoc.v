@@ -36,6 +36,14 @@ module picosoc (
 	output [31:0] iomem_wdata,
 	input  [31:0] iomem_rdata,
 
+	// second bus master (dma), tie dma_valid low if unused
+	input         dma_valid,
+	output        dma_ready,
+	input  [ 3:0] dma_wstrb,
+	input  [31:0] dma_addr,
+	input  [31:0] dma_wdata,
+	output [31:0] dma_rdata,
+
 	input  irq_5,
 	input  irq_6,
 	input  irq_7,
@@ -88,13 +96,41 @@ module picosoc (
 	end
 
 	wire mem_valid;
-	wire mem_instr;
 	wire mem_ready;
 	wire [31:0] mem_addr;
 	wire [31:0] mem_wdata;
 	wire [3:0] mem_wstrb;
 	wire [31:0] mem_rdata;
 
+	wire cpu_mem_valid;
+	wire cpu_mem_instr;
+	wire cpu_mem_ready;
+	wire [31:0] cpu_mem_addr;
+	wire [31:0] cpu_mem_wdata;
+	wire [3:0] cpu_mem_wstrb;
+
+	// bus arbitration between the cpu and the dma master. The owner only
+	// changes between transfers, and while both want the bus they take turns.
+	reg dma_grant;
+
+	assign mem_valid = dma_grant ? dma_valid : cpu_mem_valid;
+	assign mem_addr = dma_grant ? dma_addr : cpu_mem_addr;
+	assign mem_wdata = dma_grant ? dma_wdata : cpu_mem_wdata;
+	assign mem_wstrb = dma_grant ? dma_wstrb : cpu_mem_wstrb;
+
+	assign cpu_mem_ready = mem_ready && !dma_grant;
+	assign dma_ready = mem_ready && dma_grant;
+	assign dma_rdata = mem_rdata;
+
+	always @(posedge clk) begin
+		if (!resetn)
+			dma_grant <= 0;
+		else if (mem_ready)
+			dma_grant <= dma_grant ? !cpu_mem_valid : dma_valid;
+		else if (!mem_valid)
+			dma_grant <= dma_grant ? 1'b0 : dma_valid;
+	end
+
 	wire spimem_ready;
 	wire [31:0] spimem_rdata;
 
@@ -138,13 +174,13 @@ module picosoc (
 	) cpu (
 		.clk         (clk        ),
 		.resetn      (resetn     ),
-		.mem_valid   (mem_valid  ),
-		.mem_instr   (mem_instr  ),
-		.mem_ready   (mem_ready  ),
-		.mem_addr    (mem_addr   ),
-		.mem_wdata   (mem_wdata  ),
-		.mem_wstrb   (mem_wstrb  ),
-		.mem_rdata   (mem_rdata  ),
+		.mem_valid   (cpu_mem_valid),
+		.mem_instr   (cpu_mem_instr),
+		.mem_ready   (cpu_mem_ready),
+		.mem_addr    (cpu_mem_addr ),
+		.mem_wdata   (cpu_mem_wdata),
+		.mem_wstrb   (cpu_mem_wstrb),
+		.mem_rdata   (mem_rdata    ),
 		.irq         (irq        )
 	);
 
@@ -12,10 +12,44 @@ module spi_oled #(
 	output reg [31:0] ctrl_rdat,
 	output reg ctrl_done,
 
+	// byte stream from the video peripheral's OLED scan out, sent while
+	// stream mode (register 0x18) is on
+	input stream_valid,
+	input [7:0] stream_data,
+	input stream_dc,
+	output stream_ready,
+
+	output irq,                     // tx fifo almost empty
+
 	inout mosi, sclk, cs, dc, rst
 );
 	reg spi_mosi, spi_sclk, spi_cs, spi_dc, spi_rst;
 
+	reg stream_enable;
+	reg st_busy;
+	reg [3:0] st_phase;
+	reg [7:0] st_cnt;
+	reg [7:0] st_shift;
+	reg st_mosi, st_sclk, st_dc;
+
+	// tx fifo: each entry is 1-4 bytes sent first byte in bits 31:24,
+	// { dc, byte count - 1, data }. The memory is read synchronously so
+	// that it goes into block RAM, and the entry being sent is prefetched
+	// into fifo_head.
+	reg [34:0] fifo_mem [0:15];
+	reg [34:0] fifo_rdata;
+	reg [34:0] fifo_head;
+	reg fifo_head_valid;
+	reg fifo_loading;
+	reg [3:0] fifo_wptr;
+	reg [3:0] fifo_rptr;
+	reg [4:0] fifo_count;           // entries queued, including fifo_head
+	reg [4:0] fifo_mem_count;       // entries still in fifo_mem
+	reg [1:0] fifo_byte_idx;
+	reg [4:0] irq_level;
+	reg irq_enable;
+	wire use_shifter;
+
 	reg mode_cpol;
 	reg mode_cpha;
 
@@ -29,7 +63,7 @@ module spi_oled #(
 		.PULLUP(1'b 0)
 	) io_mosi (
 		.PACKAGE_PIN(mosi),
-		.D_OUT_0(spi_mosi)
+		.D_OUT_0(use_shifter ? st_mosi : spi_mosi)
 	);
 
 	SB_IO #(
@@ -37,7 +71,7 @@ module spi_oled #(
 		.PULLUP(1'b 0)
 	) io_sclk (
 		.PACKAGE_PIN(sclk),
-		.D_OUT_0(spi_sclk ^ ~mode_cpol)
+		.D_OUT_0(use_shifter ? st_sclk : spi_sclk ^ ~mode_cpol)
 	);
 
 	SB_IO #(
@@ -45,7 +79,7 @@ module spi_oled #(
 		.PULLUP(1'b 0)
 	) io_cs (
 		.PACKAGE_PIN(cs),
-		.D_OUT_0(spi_cs)
+		.D_OUT_0(use_shifter ? 1'b0 : spi_cs)
 	);
 
 	SB_IO #(
@@ -53,7 +87,7 @@ module spi_oled #(
 		.PULLUP(1'b 0)
 	) io_dc (
 		.PACKAGE_PIN(dc),
-		.D_OUT_0(spi_dc)
+		.D_OUT_0(use_shifter ? st_dc : spi_dc)
 	);
 
 	SB_IO #(
@@ -64,6 +98,100 @@ module spi_oled #(
 		.D_OUT_0(spi_rst)
 	);
 
+	// writes to 0x20-0x2c queue bytes in the tx fifo:
+	// 0x20: 4 data bytes, bits 7:0 first
+	// 0x24: a command byte
+	// 0x28: a data byte
+	// 0x2c: 4 data bytes, bits 31:24 first (two RGB565 pixels)
+	wire fifo_full = fifo_count[4];
+	wire fifo_empty = fifo_count == 0;
+	wire fifo_sel = ctrl_addr[7:4] == 4'h2;
+	wire fifo_push = resetn && ctrl_wr && !ctrl_done && fifo_sel && !fifo_full;
+	reg [34:0] fifo_entry;
+
+	always @(*) begin
+		case (ctrl_addr[3:2])
+			2'd0: fifo_entry = { 1'b1, 2'd3, ctrl_wdat[7:0], ctrl_wdat[15:8], ctrl_wdat[23:16], ctrl_wdat[31:24] };
+			2'd1: fifo_entry = { 1'b0, 2'd0, ctrl_wdat[7:0], 24'h0 };
+			2'd2: fifo_entry = { 1'b1, 2'd0, ctrl_wdat[7:0], 24'h0 };
+			2'd3: fifo_entry = { 1'b1, 2'd3, ctrl_wdat };
+		endcase
+	end
+
+	always @(posedge clk) begin
+		if (fifo_push) fifo_mem[fifo_wptr] <= fifo_entry;
+		fifo_rdata <= fifo_mem[fifo_rptr];
+	end
+
+	wire [31:0] fifo_head_data = fifo_head[31:0] << { fifo_byte_idx, 3'b000 };
+
+	assign irq = irq_enable && fifo_count <= irq_level;
+
+	// the shifter sends the stream port's bytes in stream mode, else the
+	// fifo's. It runs SPI mode 3 with the same prescale, taking the next
+	// byte as the last bit ends so the clock never stops, and holds CS low
+	// until it runs out of bytes.
+	wire st_last = st_phase == 4'd15 && st_cnt == prescale_cfg;
+	wire st_free = !st_busy || st_last;
+	assign stream_ready = stream_enable && st_free;
+	wire st_take = stream_enable ? stream_valid && st_free : fifo_head_valid && st_free;
+	wire [7:0] st_byte = stream_enable ? stream_data : fifo_head_data[31:24];
+	wire fifo_pop = !stream_enable && st_take && fifo_byte_idx == fifo_head[33:32];
+	assign use_shifter = stream_enable || st_busy || !fifo_empty;
+
+	// the next entry is read as the head is sent and lands a clock later,
+	// long before the last byte of the head has gone
+	wire fifo_load = (!fifo_head_valid || fifo_pop) && !fifo_loading && fifo_mem_count != 0;
+
+	always @(posedge clk) begin
+		if (st_busy) begin
+			st_cnt <= st_cnt == prescale_cfg ? 0 : st_cnt + 1;
+			if (st_cnt == prescale_cfg) begin
+				st_phase <= st_phase + 1;
+				if (!st_phase[0]) begin
+					st_sclk <= 1;
+				end else if (st_phase != 4'd15) begin
+					st_sclk <= 0;
+					st_mosi <= st_shift[6];
+					st_shift <= st_shift << 1;
+				end
+				if (st_last) st_busy <= 0;
+			end
+		end
+		if (st_take) begin
+			st_busy <= 1;
+			st_phase <= 0;
+			st_cnt <= 0;
+			st_shift <= st_byte;
+			st_mosi <= st_byte[7];
+			st_dc <= stream_enable ? stream_dc : fifo_head[34];
+			st_sclk <= 0;
+			if (!stream_enable) fifo_byte_idx <= fifo_pop ? 0 : fifo_byte_idx + 1;
+		end
+		if (fifo_push) fifo_wptr <= fifo_wptr + 1;
+		if (fifo_load) fifo_rptr <= fifo_rptr + 1;
+		fifo_loading <= fifo_load;
+		if (fifo_loading) begin
+			fifo_head <= fifo_rdata;
+			fifo_head_valid <= 1;
+		end else if (fifo_pop) begin
+			fifo_head_valid <= 0;
+		end
+		fifo_count <= fifo_count + fifo_push - fifo_pop;
+		fifo_mem_count <= fifo_mem_count + fifo_push - fifo_load;
+		if (!resetn) begin
+			st_busy <= 0;
+			st_sclk <= 1;
+			fifo_wptr <= 0;
+			fifo_rptr <= 0;
+			fifo_count <= 0;
+			fifo_mem_count <= 0;
+			fifo_head_valid <= 0;
+			fifo_loading <= 0;
+			fifo_byte_idx <= 0;
+		end
+	end
+
 	always @(posedge clk) begin
 		ctrl_rdat <= 'bx;
 		ctrl_done <= 0;
@@ -79,6 +207,9 @@ module spi_oled #(
 			prescale_cnt <= 0;
 			prescale_cfg <= 0;
 			spi_state <= 0;
+			stream_enable <= 0;
+			irq_enable <= 0;
+			irq_level <= 0;
 		end else
 		if (!ctrl_done) begin
 			if (ctrl_wr) begin
@@ -117,6 +248,9 @@ module spi_oled #(
 					if (mode_cpha) spi_state[4] <= 0;
 					prescale_cnt <= prescale_cnt == prescale_cfg ? 0 : prescale_cnt + 1;
 				end
+				if (ctrl_addr == 'h18) stream_enable <= ctrl_wdat;
+				if (ctrl_addr == 'h34) {irq_enable, irq_level} <= {ctrl_wdat[8], ctrl_wdat[4:0]};
+				if (fifo_sel) ctrl_done <= !fifo_full;
 				if (ctrl_addr == 'h0c) begin
 					{mode_cpol, mode_cpha} <= ctrl_wdat;
 					ctrl_done <= prescale_cnt == prescale_cfg;
@@ -131,6 +265,9 @@ module spi_oled #(
 				if (ctrl_addr == 'h0c) ctrl_rdat <= {mode_cpol, mode_cpha};
 				if (ctrl_addr == 'h10) ctrl_rdat <= spi_dc;
 				if (ctrl_addr == 'h14) ctrl_rdat <= spi_rst;
+				if (ctrl_addr == 'h18) ctrl_rdat <= stream_enable;
+				if (ctrl_addr == 'h30) ctrl_rdat <= {fifo_full, use_shifter, 3'b0, fifo_count};
+				if (ctrl_addr == 'h34) ctrl_rdat <= {irq_enable, 3'b0, irq_level};
 			end
 		end
 	end
@@ -26,7 +26,11 @@ module VGASyncGen (
   output wire      vsync,         // Vertical sync out
   output reg [9:0] x_px,          // X position for actual pixel.
   output reg [9:0] y_px,          // Y position for actual pixel.
-  output wire      activevideo    // Video is actived.
+  output wire      activevideo,   // Video is actived.
+  output wire      endframe,      // Last pixel of the last visible line (vblank starts next clock).
+  output wire      hblank,        // Horizontal blanking.
+  output wire      vblank,        // Vertical blanking.
+  output wire [9:0] line          // Visible line being scanned (only valid outside vblank).
 );
 
     /////////////////////////////////////////////////////////////
@@ -78,7 +82,7 @@ module VGASyncGen (
     parameter vlines = blackV + activeVvideo;   // Total lines.
 
     // Registers for storing the horizontal & vertical counters.
-    reg [9:0] hc;
+    reg [11:0] hc;                   // wide enough for the long OLED lines
     reg [9:0] vc;
 
     // Initial values.
@@ -114,7 +118,10 @@ module VGASyncGen (
     assign hsync = (hc >= hfp && hc < hfp + hpulse) ? 1'b0 : 1'b1;
     assign vsync = (vc >= vfp && vc < vfp + vpulse) ? 1'b0 : 1'b1;
     assign activevideo = (hc >= blackH) && (vc >= blackV) ? 1'b1 : 1'b0; //&& (hc < blackH + activeHvideo) && (vc < blackV + activeVvideo) ? 1'b1 : 1'b0;
-//    assign endframe = (hc == hpixels-1 && vc == vlines-1) ? 1'b1 : 1'b0 ;
+    assign endframe = (hc == hpixels-1 && vc == vlines-1) ? 1'b1 : 1'b0 ;
+    assign hblank = (hc < blackH) ? 1'b1 : 1'b0;
+    assign vblank = (vc < blackV) ? 1'b1 : 1'b0;
+    assign line = vc - blackV;
 
     // Generate new pixel position.
     always @(*)
@@ -0,0 +1,115 @@
+/*
+ * Display list coprocessor ("copper")
+ *
+ * Replays a list of register writes at beam positions. Each entry is two
+ * words of the list memory:
+ *
+ *  word 0 - 31: end of list (the rest of the entry is unused), 24-16: line,
+ *           7-0: target
+ *  word 1 - value
+ *
+ * The list is restarted at every vblank. Each entry waits until the beam
+ * reaches its line (the hblank before it is drawn) and then the value is
+ * written to the target, so the entries must be in line order. Several
+ * entries for the same line are applied one after another, 6 clocks each.
+ *
+ * Targets (decoded by video.v):
+ *  0x00: x scroll, 0x01: y scroll (active copies)
+ *  0x02: window, 0x03: tile remap control, 0x04: line scroll control
+ *  0x20-0x3f: palette entries 0-31
+ *  0x40-0x7f: sprite attribute words 0-63 (active copy)
+ */
+
+module copper (
+  input clk,
+  input resetn,
+
+  input enable,
+  input restart,                // start of vblank
+  input [8:0] line,             // line being drawn
+  input line_valid,             // not in vblank
+
+  input list_wen,               // list memory write port (from the CPU)
+  input [7:0] list_waddr,
+  input [31:0] list_wdata,
+
+  output write,                 // write value to target, unless stalled
+  output reg [7:0] target,
+  output reg [31:0] value,
+  input stall
+);
+
+  reg [31:0] list [0:255];      // 128 entries
+  reg [7:0] list_raddr;
+  reg [31:0] list_rdata;
+
+  always @(posedge clk) begin
+    if (list_wen)
+      list[list_waddr] <= list_wdata;
+    list_rdata <= list[list_raddr];
+  end
+
+  localparam STATE_IDLE   = 3'd0;
+  localparam STATE_FETCH  = 3'd1;
+  localparam STATE_FETCH2 = 3'd2;
+  localparam STATE_WORD0  = 3'd3;
+  localparam STATE_WORD1  = 3'd4;
+  localparam STATE_WAIT   = 3'd5;
+  localparam STATE_APPLY  = 3'd6;
+
+  reg [2:0] state;
+  reg [6:0] pc;
+  reg [8:0] wait_line;
+  reg end_of_list;
+
+  assign write = (state == STATE_APPLY);
+
+  always @(posedge clk) begin
+    if (!resetn) begin
+      state <= STATE_IDLE;
+    end else if (restart) begin
+      pc <= 0;
+      state <= enable ? STATE_FETCH : STATE_IDLE;
+    end else begin
+      case (state)
+        STATE_FETCH: begin
+          list_raddr <= { pc, 1'b0 };
+          state <= STATE_FETCH2;
+        end
+
+        STATE_FETCH2: begin
+          list_raddr <= { pc, 1'b1 };
+          state <= STATE_WORD0;
+        end
+
+        // list_rdata lags list_raddr by a clock
+        STATE_WORD0: begin
+          end_of_list <= list_rdata[31];
+          wait_line <= list_rdata[24:16];
+          target <= list_rdata[7:0];
+          state <= STATE_WORD1;
+        end
+
+        STATE_WORD1: begin
+          value <= list_rdata;
+          state <= end_of_list ? STATE_IDLE : STATE_WAIT;
+        end
+
+        STATE_WAIT: begin
+          if (!enable)
+            state <= STATE_IDLE;
+          else if (line_valid && line >= wait_line)
+            state <= STATE_APPLY;
+        end
+
+        STATE_APPLY: begin
+          if (!stall) begin
+            pc <= pc + 1;
+            state <= (pc == 7'd127) ? STATE_IDLE : STATE_FETCH;
+          end
+        end
+      endcase
+    end
+  end
+
+endmodule
@@ -0,0 +1,91 @@
+/*
+ * LCD scan out for the ILI9341 (see hdl/picosoc/ili9341)
+ *
+ * The pixel pipeline draws each line twice for VGA. The first time round
+ * the palette indices are written to a line buffer, and this module sends
+ * them to the panel as RGB565 at its pace (4 clocks a pixel) while the
+ * second scan and the next line's first scan go by. The panel cursor is
+ * reset at the start of every vblank.
+ *
+ * 1 BRAM
+ */
+
+module lcd_scanout (
+  input clk,
+  input resetn,
+
+  input frame_start,            // start of vblank
+  input capture,                // first scan of a line, active video
+  input [8:0] xpos,
+  input [4:0] index,            // palette index of the pixel at xpos
+
+  output [4:0] palette_raddr,   // the palette's read port belongs to us
+  input [17:0] palette_rdata,
+
+  output reg [15:0] pix_data,
+  output pix_clk,
+  output reset_cursor,
+  output frame_sync,
+  input busy
+);
+
+  reg [4:0] line_buffer [0:511];
+  reg [4:0] line_rdata;
+  reg [8:0] rd_x;
+
+  always @(posedge clk) begin
+    if (capture)
+      line_buffer[xpos] <= index;
+    line_rdata <= line_buffer[rd_x];
+  end
+
+  localparam STATE_IDLE   = 3'd0;
+  localparam STATE_READ   = 3'd1;
+  localparam STATE_LOOKUP = 3'd2;
+  localparam STATE_COLOUR = 3'd3;
+  localparam STATE_SEND   = 3'd4;
+
+  reg [2:0] state;
+  reg cursor_pending;
+
+  assign palette_raddr = line_rdata;
+  assign pix_clk = (state == STATE_SEND) && !busy;
+  assign reset_cursor = cursor_pending && !busy;
+  assign frame_sync = frame_start;
+
+  always @(posedge clk) begin
+    if (!resetn) begin
+      state <= STATE_IDLE;
+      cursor_pending <= 0;
+    end else begin
+      if (frame_start) cursor_pending <= 1;
+      else if (reset_cursor) cursor_pending <= 0;
+
+      // a line starts being sent as soon as it starts being captured, the
+      // reads stay behind the writes as a pixel takes 4 clocks to send
+      if (capture && xpos == 0) begin
+        rd_x <= 0;
+        state <= STATE_READ;
+      end else begin
+        case (state)
+          // line_rdata lags rd_x by a clock, and the palette another
+          STATE_READ:   state <= STATE_LOOKUP;
+          STATE_LOOKUP: state <= STATE_COLOUR;
+
+          STATE_COLOUR: begin
+            pix_data <= { palette_rdata[17:13], palette_rdata[11:6], palette_rdata[5:1] };
+            state <= STATE_SEND;
+          end
+
+          STATE_SEND: begin
+            if (!busy) begin
+              rd_x <= rd_x + 1;
+              state <= (rd_x == 9'd319) ? STATE_IDLE : STATE_READ;
+            end
+          end
+        endcase
+      end
+    end
+  end
+
+endmodule
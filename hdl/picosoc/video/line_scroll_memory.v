@@ -0,0 +1,21 @@
+
+// 1 BRAM
+// one 9 bit x offset per 320x240 line, added to the x scroll offset
+module line_scroll_memory (
+    input clk, ren, wen,
+    input [7:0] waddr, raddr,
+    input [8:0] wdata,
+    output reg [8:0] rdata
+);
+    reg [8:0] mem [0:255];
+    integer i;
+    initial
+      for (i = 0; i < 256; i = i + 1)
+        mem[i] = 9'h0;
+    always @(posedge clk) begin
+      if (ren)
+        rdata <= mem[raddr];
+      if (wen)
+        mem[waddr] <= wdata;
+    end
+endmodule
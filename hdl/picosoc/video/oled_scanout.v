@@ -0,0 +1,145 @@
+/*
+ * OLED scan out for the SSD1351 on spi_oled (see hdl/picosoc/spi_oled)
+ *
+ * Like lcd_scanout, but a 128x128 picture sent as a stream of SPI bytes.
+ * Each panel frame starts with the column and row window commands and a
+ * write RAM command, then every line follows as RGB565 (high byte first).
+ *
+ * A line is captured into the line buffer on its first scan, and sent while
+ * the pipeline carries on. With the SPI clock at 8MHz (prescale 0) that
+ * takes the time of the two scans, so every line is taken from the same
+ * frame. With a slower clock a line that is still being sent when the next
+ * one is scanned waits for the next frame, so the panel gets every line in
+ * order, just at a lower frame rate.
+ *
+ * 1 BRAM
+ */
+
+module oled_scanout (
+  input clk,
+  input resetn,
+
+  input scan,                   // first scan of a line, active video
+  input [6:0] line,
+  input [6:0] xpos,
+  input [4:0] index,            // palette index of the pixel at xpos
+
+  output [4:0] palette_raddr,   // the palette's read port belongs to us
+  input [17:0] palette_rdata,
+
+  output stream_valid,          // byte to send, held until stream_ready
+  output reg [7:0] stream_data,
+  output stream_dc,             // 0 for a command, 1 for data
+  input stream_ready
+);
+
+  reg [4:0] line_buffer [0:127];
+  reg [4:0] line_rdata;
+  reg [6:0] rd_x;
+
+  localparam STATE_IDLE    = 3'd0;
+  localparam STATE_WINDOW  = 3'd1;
+  localparam STATE_READ    = 3'd2;
+  localparam STATE_LOOKUP  = 3'd3;
+  localparam STATE_COLOUR  = 3'd4;
+  localparam STATE_SEND_HI = 3'd5;
+  localparam STATE_SEND_LO = 3'd6;
+
+  reg [2:0] state;
+  reg [6:0] want_line;
+  reg [2:0] cmd_idx;
+  reg capturing;
+  reg [15:0] pixel;
+
+  wire take_line = scan && xpos == 0 && state == STATE_IDLE && line == want_line;
+
+  always @(posedge clk) begin
+    if (scan && (take_line || capturing))
+      line_buffer[xpos] <= index;
+    line_rdata <= line_buffer[rd_x];
+
+    if (take_line)
+      capturing <= 1;
+    else if (!scan || xpos == 7'd127)
+      capturing <= 0;
+  end
+
+  // column 0-127, row 0-127, write RAM
+  reg [7:0] window_cmd;
+  always @(*) begin
+    case (cmd_idx)
+      3'd0: window_cmd = 8'h15;
+      3'd1: window_cmd = 8'h00;
+      3'd2: window_cmd = 8'h7f;
+      3'd3: window_cmd = 8'h75;
+      3'd4: window_cmd = 8'h00;
+      3'd5: window_cmd = 8'h7f;
+      default: window_cmd = 8'h5c;
+    endcase
+  end
+
+  assign palette_raddr = line_rdata;
+  assign stream_valid = (state == STATE_WINDOW) || (state == STATE_SEND_HI) || (state == STATE_SEND_LO);
+  assign stream_dc = !(state == STATE_WINDOW && (cmd_idx == 0 || cmd_idx == 3 || cmd_idx == 6));
+
+  always @(*) begin
+    case (state)
+      STATE_WINDOW:  stream_data = window_cmd;
+      STATE_SEND_HI: stream_data = pixel[15:8];
+      default:       stream_data = pixel[7:0];
+    endcase
+  end
+
+  always @(posedge clk) begin
+    if (!resetn) begin
+      state <= STATE_WINDOW;
+      cmd_idx <= 0;
+      want_line <= 0;
+      capturing <= 0;
+    end else begin
+      case (state)
+        STATE_IDLE: begin
+          if (take_line) begin
+            rd_x <= 0;
+            state <= STATE_READ;
+          end
+        end
+
+        STATE_WINDOW: begin
+          if (stream_ready) begin
+            cmd_idx <= cmd_idx + 1;
+            if (cmd_idx == 3'd6) begin
+              cmd_idx <= 0;
+              state <= STATE_IDLE;
+            end
+          end
+        end
+
+        // line_rdata lags rd_x by a clock, and the palette another
+        STATE_READ:   state <= STATE_LOOKUP;
+        STATE_LOOKUP: state <= STATE_COLOUR;
+
+        STATE_COLOUR: begin
+          pixel <= { palette_rdata[17:13], palette_rdata[11:6], palette_rdata[5:1] };
+          state <= STATE_SEND_HI;
+        end
+
+        STATE_SEND_HI: if (stream_ready) state <= STATE_SEND_LO;
+
+        // the next pixel is looked up while this byte is shifted out
+        STATE_SEND_LO: begin
+          if (stream_ready) begin
+            rd_x <= rd_x + 1;
+            if (rd_x != 7'd127) begin
+              state <= STATE_READ;
+            end else begin
+              want_line <= want_line + 1;
+              state <= (want_line == 7'd127) ? STATE_WINDOW : STATE_IDLE;
+            end
+          end
+        end
+      endcase
+    end
+  end
+
+endmodule
@@ -0,0 +1,23 @@
+
+// 1 BRAM
+// 32 colours of 18 bit RGB (red 17-12, green 11-6, blue 5-0), 0-15 for
+// texels and 16-31 for sprites. Both halves start as the 8 colours of the
+// old 3 bit RGB (bit 0 red, 1 green, 2 blue).
+module palette_memory (
+    input clk, ren, wen,
+    input [4:0] waddr, raddr,
+    input [17:0] wdata,
+    output reg [17:0] rdata
+);
+    reg [17:0] mem [0:31];
+    integer i;
+    initial
+      for (i = 0; i < 32; i = i + 1)
+        mem[i] = { {6{i[0]}}, {6{i[1]}}, {6{i[2]}} };
+    always @(posedge clk) begin
+      if (ren)
+        rdata <= mem[raddr];
+      if (wen)
+        mem[waddr] <= wdata;
+    end
+endmodule
@@ -0,0 +1,21 @@
+
+// 1 BRAM
+// two 32 bit attribute words per sprite, word 1 of sprite n at 32 + n
+// (layout in sprite_engine.v)
+module sprite_attribute_memory (
+    input clk, ren,
+    input [3:0] wen,
+    input [5:0] waddr, raddr,
+    input [31:0] wdata,
+    output reg [31:0] rdata
+);
+    reg [31:0] mem [0:63];   // 32 sprites
+    always @(posedge clk) begin
+      if (ren)
+        rdata <= mem[raddr];
+      if (wen[0]) mem[waddr][ 7: 0] <= wdata[ 7: 0];
+      if (wen[1]) mem[waddr][15: 8] <= wdata[15: 8];
+      if (wen[2]) mem[waddr][23:16] <= wdata[23:16];
+      if (wen[3]) mem[waddr][31:24] <= wdata[31:24];
+    end
+endmodule
@@ -0,0 +1,284 @@
+/*
+ * Scanline sprite engine
+ *
+ * While one line is on screen the next one is built in the other half of a
+ * double line buffer: the buffer is cleared, all sprite attributes are
+ * scanned for sprites that cross the line (the first MAX_PER_LINE, in sprite
+ * order, are kept) and then those sprites' rows are drawn into the buffer,
+ * lowest numbered sprite last so it ends up on top.
+ *
+ * A second, single line owner buffer records which sprite drew each pixel,
+ * so a sprite drawing over an earlier one reports the pair as overlapping.
+ *
+ * Sprites with an animation descriptor step through consecutive images:
+ * once a frame (on advance) the engine walks the descriptors and moves each
+ * sprite's frame counter on, and the frame is added to the image as it is
+ * drawn.
+ *
+ * Each 320x240 line is scanned twice by the VGA timing, which leaves ~850
+ * clocks per line; clearing takes 320, the scan NUM_SPRITES+2 and each
+ * sprite drawn 21.
+ */
+
+module sprite_engine #(
+  parameter NUM_SPRITES = 32,
+  parameter MAX_PER_LINE = 16
+) (
+  input clk,
+  input resetn,
+
+  input start,                 // start building a line
+  input advance,               // step the sprite animations (once a frame)
+  input [8:0] line,            // the line to build
+
+  output reg [5:0] attr_raddr, // sprite attribute memory read port
+  input [31:0] attr_rdata,
+
+  output reg [8:0] spritemem_raddr, // sprite memory read port
+  input [31:0] spritemem_rdata,
+
+  input [8:0] xpos,            // display read port
+  input buffer,
+  output reg [9:0] pixel,      // 9-5: sprite number, 4: opaque, 3-0: colour
+
+  output reg overflow,         // pulses when a line has too many sprites
+
+  output reg overlap,          // pulses when opaque pixels of two sprites meet
+  output reg [4:0] overlap_a,
+  output reg [4:0] overlap_b
+);
+
+  /////////////////////////////////////////////////////////////////
+  // Sprite attribute unpacking, two words per sprite
+  /////////////////////////////////////////////////////////////////
+  // word 0 (attribute memory 0-31)
+  // | 31-30 | 29     | 28-26   |     25-20      | 19-10 | 9:0  |
+  // | N/A   | enable | colour  | 0-64 sprite #  | xpos  | ypos |
+  //
+  // word 1 (attribute memory 32-63)
+  // | 31-16 | 15-12 | 11-8   | 7-6 | 5-4     | 3   | 2     | 1     | 0     |
+  // | N/A   | rate  | frames | N/A | palette | N/A | 2bpp  | vflip | hflip |
+  //
+  // an animated sprite shows images image .. image + frames (doubled for
+  // 2bpp), each for rate + 1 frames; frames = 0 is not animated
+  //
+  // 1bpp images are two rows per sprite memory word (even row in the top
+  // half), set pixels are drawn in colour. 2bpp images take a word per row,
+  // so two image numbers; pixel values 1-3 are drawn in colour
+  // palette * 4 + value and 0 is transparent. Leftmost pixel in the top bits.
+  /////////////////////////////////////////////////////////////////
+
+  localparam STATE_IDLE   = 4'd0;
+  localparam STATE_CLEAR  = 4'd1;
+  localparam STATE_EVAL   = 4'd2;
+  localparam STATE_LIST   = 4'd3;
+  localparam STATE_ATTR   = 4'd4;
+  localparam STATE_FETCH  = 4'd5;
+  localparam STATE_ROW    = 4'd6;
+  localparam STATE_FLAGS  = 4'd7;
+  localparam STATE_LOAD   = 4'd8;
+  localparam STATE_DRAW   = 4'd9;
+  localparam STATE_ANIM   = 4'd10;
+
+  reg [3:0] state;
+  reg [8:0] target_line;
+  reg [8:0] clear_x;
+  reg [4:0] eval_idx;
+  reg eval_primed;
+
+  // sprites found on the line, sprite number and row within the sprite
+  reg [4:0] list_idx [0:MAX_PER_LINE-1];
+  reg [3:0] list_row [0:MAX_PER_LINE-1];
+  reg [4:0] list_count;
+  reg [4:0] draw_k;
+
+  reg [9:0] draw_x;
+  reg [3:0] draw_i;
+  reg [2:0] draw_colour;
+  reg [4:0] draw_idx;
+  reg [5:0] draw_image;
+  reg [3:0] draw_row;
+  reg draw_hflip;
+  reg draw_2bpp;
+  reg [1:0] draw_palette;
+  reg image_row_odd;
+
+  // animation state per sprite: current frame and frames shown so far
+  reg [3:0] anim_frame [0:NUM_SPRITES-1];
+  reg [3:0] anim_tick [0:NUM_SPRITES-1];
+
+  wire [9:0] attr_ypos   = attr_rdata[ 9: 0];
+  wire [9:0] attr_xpos   = attr_rdata[19:10];
+  wire [5:0] attr_image  = attr_rdata[25:20];
+  wire [2:0] attr_colour = attr_rdata[28:26];
+  wire attr_enable       = attr_rdata[   29];
+
+  wire attr_hflip        = attr_rdata[0];
+  wire attr_vflip        = attr_rdata[1];
+  wire attr_2bpp         = attr_rdata[2];
+  wire [1:0] attr_palette = attr_rdata[5:4];
+  wire [3:0] attr_frames = attr_rdata[11:8];
+  wire [3:0] attr_rate   = attr_rdata[15:12];
+
+  wire [9:0] attr_row = {1'b0, target_line} - attr_ypos;
+  wire on_line = attr_enable && (attr_row < 16);
+
+  // row as stored, after the vertical flip
+  wire [3:0] image_row = attr_vflip ? ~draw_row : draw_row;
+  wire [5:0] anim_image = draw_image + (attr_2bpp ? { 1'b0, anim_frame[draw_idx], 1'b0 } : { 2'b0, anim_frame[draw_idx] });
+
+  wire [3:0] column = draw_hflip ? ~draw_i : draw_i;
+  wire [15:0] row_pixels = image_row_odd ? spritemem_rdata[15:0] : spritemem_rdata[31:16];
+  wire [1:0] pixel_2bpp = spritemem_rdata[{~column, 1'b0} +: 2];
+  wire pixel_set = draw_2bpp ? (pixel_2bpp != 0) : row_pixels[~column];
+  wire [3:0] pixel_colour = draw_2bpp ? { draw_palette, pixel_2bpp } : { 1'b0, draw_colour };
+  wire draw_pixel = pixel_set && (draw_x < 320);
+
+  // double line buffer, target_line[0] selects the half being built
+  reg [9:0] line_buffer [0:1023];
+  wire lb_wen = (state == STATE_CLEAR) || (state == STATE_DRAW && draw_pixel);
+  wire [8:0] lb_x = (state == STATE_CLEAR) ? clear_x : draw_x[8:0];
+  wire [9:0] lb_wdata = (state == STATE_CLEAR) ? 10'h0 : { draw_idx, 1'b1, pixel_colour };
+
+  always @(posedge clk) begin
+    if (lb_wen)
+      line_buffer[{target_line[0], lb_x}] <= lb_wdata;
+    pixel <= line_buffer[{buffer, xpos}];
+  end
+
+  // owner buffer for the line being built: 5: drawn, 4-0: sprite number
+  // it is read as each pixel is drawn, so holds the sprite drawn before
+  reg [5:0] owner_buffer [0:511];
+  reg [5:0] owner_rdata;
+  reg drew_pixel;
+
+  always @(posedge clk) begin
+    if (lb_wen)
+      owner_buffer[lb_x] <= { lb_wdata[4], lb_wdata[9:5] };
+    owner_rdata <= owner_buffer[lb_x];
+    drew_pixel <= (state == STATE_DRAW && draw_pixel);
+    overlap <= drew_pixel && owner_rdata[5];
+    overlap_a <= draw_idx;
+    overlap_b <= owner_rdata[4:0];
+  end
+
+  always @(posedge clk) begin
+    overflow <= 0;
+    if (!resetn) begin
+      state <= STATE_IDLE;
+    end else if (start) begin
+      target_line <= line;
+      clear_x <= 0;
+      list_count <= 0;
+      state <= STATE_CLEAR;
+    end else if (advance) begin
+      attr_raddr <= { 1'b1, 5'd0 };
+      eval_idx <= 0;
+      eval_primed <= 0;
+      state <= STATE_ANIM;
+    end else begin
+      case (state)
+        STATE_CLEAR: begin
+          clear_x <= clear_x + 1;
+          if (clear_x == 319) begin
+            attr_raddr <= 0;
+            eval_idx <= 0;
+            eval_primed <= 0;
+            state <= STATE_EVAL;
+          end
+        end
+
+        // attr_rdata lags attr_raddr by a clock, so holds sprite eval_idx
+        STATE_EVAL: begin
+          attr_raddr <= attr_raddr + 1;
+          eval_primed <= 1;
+          if (eval_primed) begin
+            if (on_line) begin
+              if (list_count == MAX_PER_LINE) begin
+                overflow <= 1;
+              end else begin
+                list_idx[list_count] <= eval_idx;
+                list_row[list_count] <= attr_row[3:0];
+                list_count <= list_count + 1;
+              end
+            end
+            eval_idx <= eval_idx + 1;
+            if (eval_idx == NUM_SPRITES-1) state <= STATE_LIST;
+          end
+        end
+
+        STATE_LIST: begin
+          draw_k <= list_count - 1;
+          state <= (list_count == 0) ? STATE_IDLE : STATE_ATTR;
+        end
+
+        STATE_ATTR: begin
+          attr_raddr <= { 1'b0, list_idx[draw_k] };
+          state <= STATE_FETCH;
+        end
+
+        STATE_FETCH: begin
+          attr_raddr <= { 1'b1, list_idx[draw_k] };
+          state <= STATE_ROW;
+        end
+
+        // word 0 of the sprite being drawn is on attr_rdata
+        STATE_ROW: begin
+          draw_image <= attr_image;
+          draw_row <= list_row[draw_k];
+          draw_colour <= attr_colour;
+          draw_idx <= list_idx[draw_k];
+          draw_x <= attr_xpos;
+          draw_i <= 0;
+          state <= STATE_FLAGS;
+        end
+
+        // word 1 is on attr_rdata
+        STATE_FLAGS: begin
+          if (attr_2bpp)
+            spritemem_raddr <= { anim_image, 3'b0 } + image_row;
+          else
+            spritemem_raddr <= { anim_image, image_row[3:1] };
+          image_row_odd <= image_row[0];
+          draw_hflip <= attr_hflip;
+          draw_2bpp <= attr_2bpp;
+          draw_palette <= attr_palette;
+          state <= STATE_LOAD;
+        end
+
+        STATE_LOAD: begin
+          state <= STATE_DRAW;
+        end
+
+        // the row is on spritemem_rdata from here on
+        STATE_DRAW: begin
+          draw_x <= draw_x + 1;
+          draw_i <= draw_i + 1;
+          if (draw_i == 15) begin
+            draw_k <= draw_k - 1;
+            state <= (draw_k == 0) ? STATE_IDLE : STATE_ATTR;
+          end
+        end
+        // word 1 of sprite eval_idx is on attr_rdata, as in STATE_EVAL
+        STATE_ANIM: begin
+          attr_raddr <= attr_raddr + 1;
+          eval_primed <= 1;
+          if (eval_primed) begin
+            if (attr_frames == 0) begin
+              anim_frame[eval_idx] <= 0;
+              anim_tick[eval_idx] <= 0;
+            end else if (anim_tick[eval_idx] >= attr_rate) begin
+              anim_tick[eval_idx] <= 0;
+              anim_frame[eval_idx] <= (anim_frame[eval_idx] >= attr_frames) ? 4'd0 : anim_frame[eval_idx] + 1;
+            end else begin
+              anim_tick[eval_idx] <= anim_tick[eval_idx] + 1;
+            end
+            eval_idx <= eval_idx + 1;
+            if (eval_idx == NUM_SPRITES-1) state <= STATE_IDLE;
+          end
+        end
+      endcase
+    end
+  end
+
+endmodule
@@ -1,17 +1,21 @@
 // 4 BRAMS
+// stored as 512 pairs of 16 pixel sprite rows, with a write enable per pixel
+// so a pair of rows can be written in one go.  The even row is in bits 31:16,
+// the odd row in bits 15:0, and the leftmost pixel is the most significant bit.
 module sprite_memory (
-    input clk, wen, ren,
-    input [13:0] waddr, raddr,
-    input wdata,
-    output reg rdata
+    input clk, ren,
+    input [31:0] wen,
+    input [8:0] waddr, raddr,
+    input [31:0] wdata,
+    output reg [31:0] rdata
 );
-    reg [0:0] mem [0:16383];   // enough memory for 64 16x16 sprites @ 1bpp
+    reg [31:0] mem [0:511];   // enough memory for 64 16x16 sprites @ 1bpp
+    integer i;
     always @(posedge clk) begin
       if (ren)
         rdata <= mem[raddr];
-      if (wen)
-        mem[waddr] <= wdata;
+      for (i = 0; i < 32; i = i + 1)
+        if (wen[i])
+          mem[waddr][i] <= wdata[i];
     end
 endmodule
-
-
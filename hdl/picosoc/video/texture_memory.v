@@ -1,16 +1,21 @@
-// 3 BRAMS
+
+// 4 BRAMS
+// stored as 512 rows of 8 texels (texel x in bits 4x+3:4x), with a write
+// enable per texel so a whole texture row can be written in one go
 module texture_memory (
-    input clk, wen, ren,
-    input [11:0] waddr, raddr,
-    input [2:0] wdata,
-    output reg [2:0] rdata
+    input clk, ren,
+    input [7:0] wen,
+    input [8:0] waddr, raddr,
+    input [31:0] wdata,
+    output reg [31:0] rdata
 );
-    reg [2:0] mem [0:4095];   // enough memory for 64 8x8 texture tiles @ 3bpp // uses 4/32 BRAMS of Ice40
+    reg [31:0] mem [0:511];   // enough memory for 64 8x8 texture tiles @ 4bpp // uses 4/32 BRAMS of Ice40
+    integer i;
     always @(posedge clk) begin
       if (ren)
         rdata <= mem[raddr];
-      if (wen)
-        mem[waddr] <= wdata;
+      for (i = 0; i < 8; i = i + 1)
+        if (wen[i])
+          mem[waddr][i*4 +: 4] <= wdata[i*4 +: 4];
     end
 endmodule
-
@@ -1,17 +1,21 @@
+
 // 6 BRAMS
+// stored as 1024 groups of 4 tile indices (tile x in bits 6x+5:6x), with a
+// write enable per tile so a whole group can be written in one go
 module tile_memory (
-    input clk, wen, ren,
-    input [11:0] waddr, raddr,
-    input [5:0] wdata,
-    output reg [5:0] rdata
+    input clk, ren,
+    input [3:0] wen,
+    input [9:0] waddr, raddr,
+    input [23:0] wdata,
+    output reg [23:0] rdata
 );
-    reg [5:0] mem [0:4095];   // enough memory for 80x50 map of tiles // uses ~6 BRAMS of Ice40
+    reg [23:0] mem [0:1023];   // enough memory for 64x64 map of tiles // uses ~6 BRAMS of Ice40
+    integer i;
     always @(posedge clk) begin
       if (ren)
         rdata <= mem[raddr];
-      if (wen)
-        mem[waddr] <= wdata;
+      for (i = 0; i < 4; i = i + 1)
+        if (wen[i])
+          mem[waddr][i*6 +: 6] <= wdata[i*6 +: 6];
     end
 endmodule
-
-
@@ -0,0 +1,22 @@
+
+// 1 BRAM
+// 4 banks of 64 entries, each mapping a tile number to the texture drawn
+// for it (entry bank * 64 + tile). Every bank starts as the identity map.
+module tile_remap_memory (
+    input clk, ren, wen,
+    input [7:0] waddr, raddr,
+    input [5:0] wdata,
+    output reg [5:0] rdata
+);
+    reg [5:0] mem [0:255];
+    integer i;
+    initial
+      for (i = 0; i < 256; i = i + 1)
+        mem[i] = i[5:0];
+    always @(posedge clk) begin
+      if (ren)
+        rdata <= mem[raddr];
+      if (wen)
+        mem[waddr] <= wdata;
+    end
+endmodule
@@ -2,11 +2,25 @@
  * Video peripheral for TinyFPGA game SoC
  *
  * 320x240 tile map based graphics adaptor
- *  texture memory mapped to 0x0510_0000
- *  tile memory mapped to 0x0520_0000
+ *  texture memory mapped to 0x0510_0000 (packed rows of 8 texels at 0x0518_0000)
+ *  tile memory mapped to 0x0520_0000 (packed groups of 4 tiles at 0x0528_0000)
+ *  sprite memory mapped to 0x0530_0000 (packed pairs of rows at 0x0538_0000)
+ *  sprite attributes mapped to 0x0540_0000
+ *  colour palette mapped to 0x0550_0000
+ *  tile remap table mapped to 0x0560_0000
+ *  window tile map mapped to 0x0570_0000 (packed groups of 4 tiles at 0x0578_0000)
+ *  line scroll table mapped to 0x0580_0000
+ *  copper display list mapped to 0x0590_0000
+ *  control/status registers mapped to 0x0500_0040
+ *
+ * The output is VGA, or with LCD set RGB565 pixels for the ili9341 module,
+ * or with OLED set a stream of SPI bytes for spi_oled
  */
 
-module video
+module video #(
+  parameter LCD = 0,            // drive an ILI9341 panel instead of VGA
+  parameter OLED = 0            // drive a 128x128 SSD1351 through spi_oled instead of VGA
+)
 (
   input resetn,
   input clk,
@@ -14,11 +28,23 @@ module video
 	input [3:0]  iomem_wstrb,
 	input [31:0] iomem_addr,
 	input [31:0] iomem_wdata,
+	output reg [31:0] iomem_rdata,
+	output iomem_ready,
+  output irq,
   output vga_hsync,
   output vga_vsync,
   output vga_r,
   output vga_g,
-  output vga_b);
+  output vga_b,
+  output [15:0] lcd_pix_data,
+  output lcd_pix_clk,
+  output lcd_reset_cursor,
+  output lcd_frame_sync,
+  input lcd_busy,
+  output [7:0] oled_data,
+  output oled_dc,
+  output oled_valid,
+  input oled_ready);
 
   reg[9:0] xpos;
   reg[9:0] ypos;
@@ -28,129 +54,466 @@ module video
 
   wire[8:0] next_xpos = half_xpos+1;
   wire video_active;
+  wire vblank_start;
+  wire hblank;
+  wire vblank;
+  wire [9:0] line;
 
   // video registers
   // 0: x scroll offset
   // 1: y scroll offset
-  // 2,3,4,5: sprite registers for sprites 1-4
+  // 2-9: attributes of sprites 0-7 (alias of the sprite attribute memory)
+  //
+  // the CPU writes the shadow copy (config_register_bank and the shadow
+  // sprite attributes), the pixel pipeline only ever reads the active copy,
+  // which is latched at vblank
 
-  localparam NUM_SPRITES = 8;
+  localparam NUM_SPRITES = 32;
 
-	reg [31:0] config_register_bank [0:NUM_SPRITES+1];
+	reg [31:0] config_register_bank [0:1];
+	reg [31:0] active_register_bank [0:1];
   wire [3:0] bank_addr = iomem_addr[5:2];
 
-  // todo sprites
-  // sprite_memory spritemem();
-
   wire reg_write = (iomem_addr[23:20]==4'h0);
+  wire bank_sel = reg_write && iomem_addr[7:6] == 2'b00;
+  wire bank_write = bank_sel && bank_addr < 2;
+  wire legacy_attr_write = bank_sel && bank_addr >= 2 && bank_addr < 10;
+  wire ctrl_sel = reg_write && iomem_addr[7:6] != 2'b00;
+  wire ctrl_write = (iomem_valid && iomem_wstrb[0] && ctrl_sel);
+  wire [5:0] ctrl_addr = iomem_addr[7:2] - 6'h10;  // 0x40 onwards
   wire texmem_write = (iomem_valid && iomem_wstrb[0] && iomem_addr[23:20]==4'h1);
   wire tilemem_write = (iomem_valid && iomem_wstrb[0] && iomem_addr[23:20]==4'h2);
   wire spritemem_write = (iomem_valid && iomem_wstrb[0] && iomem_addr[23:20]==4'h3);
+  wire attrmem_write = iomem_valid && (iomem_addr[23:20]==4'h4 || legacy_attr_write);
+  wire palette_write = (iomem_valid && iomem_wstrb[0] && iomem_addr[23:20]==4'h5);
+  wire remap_write = (iomem_valid && iomem_wstrb[0] && iomem_addr[23:20]==4'h6);
+  wire windowmem_write = (iomem_valid && iomem_wstrb[0] && iomem_addr[23:20]==4'h7);
+  wire linescroll_write = (iomem_valid && iomem_wstrb[0] && iomem_addr[23:20]==4'h8);
+  wire copper_list_write = (iomem_valid && iomem_wstrb[0] && iomem_addr[23:20]==4'h9);
+
+  // bit 19 of the address selects the packed aperture of each memory,
+  // otherwise each store writes a single texel/tile/pixel
+  wire packed_write = iomem_addr[19];
+
+  // vram data port: writes a single item at vram_addr, then moves it on
+  // vram_addr - 20: stride 64 (else 1), 17-16: memory (texture/tile/sprite/window), 13-0: item
+  reg [20:0] vram_addr;
+  wire [1:0] vram_target = vram_addr[17:16];
+  wire port_write = ctrl_write && ctrl_addr == 6'h8;
+
+  always @(posedge clk) begin
+    if (ctrl_write && ctrl_addr == 6'h7) vram_addr <= iomem_wdata[20:0];
+    if (port_write) vram_addr[13:0] <= vram_addr[13:0] + (vram_addr[20] ? 14'd64 : 14'd1);
+  end
+
+  // single item writes, from either the per item apertures or the data port
+  wire [13:0] item_addr = port_write ? vram_addr[13:0] : iomem_addr[15:2];
+  wire texmem_item = port_write ? (vram_target == 2'd0) : (texmem_write && !packed_write);
+  wire tilemem_item = port_write ? (vram_target == 2'd1) : (tilemem_write && !packed_write);
+  wire spritemem_item = port_write ? (vram_target == 2'd2) : (spritemem_write && !packed_write);
+  wire windowmem_item = port_write ? (vram_target == 2'd3) : (windowmem_write && !packed_write);
+
+  wire [7:0] texmem_wen = (texmem_write && packed_write) ? 8'hff : texmem_item ? (8'h01 << item_addr[2:0]) : 8'h0;
+  wire [8:0] texmem_waddr = packed_write ? iomem_addr[10:2] : item_addr[11:3];
+  wire [31:0] texmem_wdata = packed_write ? iomem_wdata : {8{iomem_wdata[3:0]}};
+
+  wire [3:0] tilemem_wen = (tilemem_write && packed_write) ? 4'hf : tilemem_item ? (4'h1 << item_addr[1:0]) : 4'h0;
+  wire [9:0] tilemem_waddr = packed_write ? iomem_addr[11:2] : item_addr[11:2];
+  wire [23:0] tilemem_wdata = packed_write ? iomem_wdata[23:0] : {4{iomem_wdata[5:0]}};
+
+  wire [3:0] windowmem_wen = (windowmem_write && packed_write) ? 4'hf : windowmem_item ? (4'h1 << item_addr[1:0]) : 4'h0;
+  wire [7:0] windowmem_waddr = packed_write ? iomem_addr[9:2] : item_addr[9:2];
+
+  wire [31:0] spritemem_wen = (spritemem_write && packed_write) ? 32'hffffffff : spritemem_item ? (32'h80000000 >> item_addr[4:0]) : 32'h0;
+  wire [8:0] spritemem_waddr = packed_write ? iomem_addr[10:2] : item_addr[13:5];
+  wire [31:0] spritemem_wdata = packed_write ? iomem_wdata : {32{iomem_wdata[0]}};
+
+  wire [23:0] tile_read_row;
+  wire [31:0] texture_read_row;
+  reg [1:0] tile_read_sel;
+  reg [2:0] texture_read_sel;
+
+  wire [5:0] tile_read_data = tile_read_row[tile_read_sel*6 +: 6];
+  wire [3:0] texture_read_data = texture_read_row[texture_read_sel*4 +: 4];
+
+  // CPU reads of the tile map and the sprite attributes go through the
+  // memories' read ports, so they take an extra clock. The tile map port
+  // belongs to the pixel pipeline during active video, so those reads wait
+  // for the next blanking interval; attribute reads wait for the copy.
+  wire reg_read = iomem_valid && iomem_wstrb == 4'h0;
+  wire tilemem_read = reg_read && iomem_addr[23:20]==4'h2;
+  wire attrmem_read = reg_read && (iomem_addr[23:20]==4'h4 ||
+                      (bank_sel && bank_addr >= 2 && bank_addr < 10));
+  reg read_done;
+  wire cpu_tile_read = tilemem_read && !video_active && !read_done;
+  wire cpu_attr_read;
+  wire [9:0] cpu_tile_row = packed_write ? iomem_addr[11:2] : iomem_addr[13:4];
+
+  assign iomem_ready = !(tilemem_read || attrmem_read) || read_done;
 
-  wire [5:0] tile_read_data;
-  wire [2:0] texture_read_data;
+  always @(posedge clk)
+    read_done <= resetn && (cpu_tile_read || cpu_attr_read);
 
-  wire [9:0] xofs = config_register_bank[0][8:0];
-  wire [9:0] yofs = config_register_bank[1][8:0];
+  // copper: replays register writes from its display list as the beam
+  // reaches each line (targets in copper.v), waiting for a clock when
+  // nothing else is writing the same register or memory
+  reg copper_enable;
+  wire copper_write;
+  wire [7:0] copper_target;
+  wire [31:0] copper_value;
+  wire copper_stall;
+  wire copper_apply = copper_write && !copper_stall;
+
+  copper coprocessor(
+    .clk(clk),
+    .resetn(resetn),
+    .enable(copper_enable),
+    .restart(vblank_start),
+    .line(line[9:1]),
+    .line_valid(!vblank),
+    .list_wen(copper_list_write), .list_waddr(iomem_addr[9:2]), .list_wdata(iomem_wdata),
+    .write(copper_write),
+    .target(copper_target),
+    .value(copper_value),
+    .stall(copper_stall)
+  );
+
+  wire copper_scroll = copper_apply && copper_target[7:1] == 7'h0;
+  wire copper_palette = copper_apply && copper_target[7:5] == 3'b001;
+  wire copper_attr = copper_apply && copper_target[7:6] == 2'b01;
+
+  // registers written by either the CPU or the copper (the copper stalls
+  // while the CPU writes any control register)
+  wire [31:0] reg_wdata = copper_apply ? copper_value : iomem_wdata;
+  wire remap_reg_write = (ctrl_write && ctrl_addr == 6'hb) || (copper_apply && copper_target == 8'h03);
+  wire window_reg_write = (ctrl_write && ctrl_addr == 6'hc) || (copper_apply && copper_target == 8'h02);
+  wire line_scroll_reg_write = (ctrl_write && ctrl_addr == 6'hd) || (copper_apply && copper_target == 8'h04);
+
+  // line scroll: an extra x offset per line, read from the table by line
+  // (which unlike half_ypos is valid in hblank, so it is ready in time)
+  reg line_scroll_enable;
+  wire [8:0] line_scroll;
+
+  line_scroll_memory linescroll(
+    .clk(clk),
+    .ren(1'b1), .raddr(line[8:1]), .rdata(line_scroll),
+    .wen(linescroll_write), .waddr(iomem_addr[9:2]), .wdata(iomem_wdata[8:0])
+  );
+
+  wire [9:0] xofs = active_register_bank[0][8:0] + (line_scroll_enable ? line_scroll : 9'h0);
+  wire [9:0] yofs = active_register_bank[1][8:0];
 
   wire [9:0] effective_y = half_ypos+yofs;
   wire [9:0] effective_x = half_xpos+xofs;
-  wire [9:0] effective_next_x = next_xpos+xofs;
+  wire [9:0] effective_next2_x = next_xpos+1+xofs;
 
   // need to read ahead with tile memory to prevent edge-artifacts
-  wire [11:0] tile_read_address = { effective_y[8:3], effective_next_x[8:3] };
+  // (the memories return a whole row, the column is picked out a clock later,
+  // then the tile goes through the remap table, which is another clock)
+  // in page mode the tile memory is two 64x32 pages, and the page shown
+  // replaces the top bit of the tile row
+  reg tile_page_mode;
+  reg tile_page;
+  wire [5:0] tile_read_row_y = tile_page_mode ? { tile_page, effective_y[7:3] } : effective_y[8:3];
+  wire [11:0] tile_read_address = { tile_read_row_y, effective_next2_x[8:3] };
+
+  // tile fill: fills a rectangle of the tile memory with one tile, a group
+  // of 4 tiles per clock, on clocks when the CPU is not writing tiles
+  // command - 29-24: tile, 23-18: height - 1, 17-12: width - 1, 11-6: y, 5-0: x
+  // a command written while busy is dropped and sets fill_dropped, which
+  // stays set until a write with bit 31 set clears it
+  reg fill_busy;
+  reg fill_dropped;
+  reg [5:0] fill_x0;
+  reg [5:0] fill_x1;
+  reg [5:0] fill_y;
+  reg [5:0] fill_y1;
+  reg [3:0] fill_group;
+  reg [5:0] fill_tile;
+
+  wire fill_cmd = ctrl_write && ctrl_addr == 6'hf && !iomem_wdata[31];
+  wire fill_start = fill_cmd && !fill_busy;
+  wire [6:0] fill_end_x = iomem_wdata[5:0] + iomem_wdata[17:12];
+  wire [6:0] fill_end_y = iomem_wdata[11:6] + iomem_wdata[23:18];
+
+  wire fill_write = fill_busy && tilemem_wen == 4'h0;
+  reg [3:0] fill_wen;
+  integer f;
+  always @(*)
+    for (f = 0; f < 4; f = f + 1)
+      fill_wen[f] = { fill_group, f[1:0] } >= fill_x0 && { fill_group, f[1:0] } <= fill_x1;
+
+  always @(posedge clk) begin
+    if (fill_start) begin
+      fill_busy <= 1;
+      fill_x0 <= iomem_wdata[5:0];
+      fill_x1 <= fill_end_x[6] ? 6'd63 : fill_end_x[5:0];
+      fill_y <= iomem_wdata[11:6];
+      fill_y1 <= fill_end_y[6] ? 6'd63 : fill_end_y[5:0];
+      fill_group <= iomem_wdata[5:2];
+      fill_tile <= iomem_wdata[29:24];
+    end else if (fill_write) begin
+      if (fill_group == fill_x1[5:2]) begin
+        fill_group <= fill_x0[5:2];
+        fill_y <= fill_y + 1;
+        if (fill_y == fill_y1) fill_busy <= 0;
+      end else begin
+        fill_group <= fill_group + 1;
+      end
+    end
+    if (fill_cmd && fill_busy) fill_dropped <= 1;
+    if (ctrl_write && ctrl_addr == 6'hf && iomem_wdata[31]) fill_dropped <= 0;
+    if (!resetn) begin
+      fill_busy <= 0;
+      fill_dropped <= 0;
+    end
+  end
+
   tile_memory tilemem(
     .clk(clk),
-    .ren(video_active), .raddr(tile_read_address), .rdata(tile_read_data),
-    .wen(tilemem_write), .waddr(iomem_addr[13:2]), .wdata(iomem_wdata[5:0])
+    .ren(video_active || cpu_tile_read),
+    .raddr(cpu_tile_read ? cpu_tile_row : tile_read_address[11:2]), .rdata(tile_read_row),
+    .wen(fill_write ? fill_wen : tilemem_wen),
+    .waddr(fill_write ? { fill_y, fill_group } : tilemem_waddr),
+    .wdata(fill_write ? {4{fill_tile}} : tilemem_wdata)
+  );
+
+  // window: a 32x32 tile plane that ignores scrolling, drawn instead of the
+  // background from (window_x, window_y) to the bottom right of the screen
+  reg window_enable;
+  reg window_priority;
+  reg [8:0] window_x;
+  reg [8:0] window_y;
+
+  wire [8:0] window_read_x = next_xpos + 1 - window_x;
+  wire [8:0] window_row_y = half_ypos - window_y;
+  wire [8:0] window_col_x = half_xpos - window_x;
+  wire in_window_ahead = window_enable && (next_xpos + 1 >= window_x) && (half_ypos >= window_y);
+
+  wire [23:0] window_read_row;
+  reg [1:0] window_read_sel;
+  reg [2:0] in_window;  // in_window_ahead, delayed to match each stage
+  wire [5:0] window_read_data = window_read_row[window_read_sel*6 +: 6];
+
+  window_memory windowmem(
+    .clk(clk),
+    .ren(video_active), .raddr({ window_row_y[7:3], window_read_x[7:5] }), .rdata(window_read_row),
+    .wen(windowmem_wen), .waddr(windowmem_waddr), .wdata(tilemem_wdata)
+  );
+
+  always @(posedge clk) begin
+    if (video_active) begin
+      window_read_sel <= window_read_x[4:3];
+      in_window <= { in_window[1:0], in_window_ahead };
+    end
+  end
+
+  // tile remap: the texture drawn for each tile number comes from the
+  // current bank of the remap table, so changing one entry (or the bank)
+  // animates every cell using that tile
+  reg [1:0] remap_bank;
+  reg [1:0] remap_last_bank;
+  reg remap_auto;
+  reg [3:0] remap_rate;
+  reg [3:0] remap_tick;
+  wire [5:0] remapped_tile;
+
+  tile_remap_memory remap(
+    .clk(clk),
+    .ren(video_active), .raddr({ remap_bank, in_window[0] ? window_read_data : tile_read_data }), .rdata(remapped_tile),
+    .wen(remap_write), .waddr(iomem_addr[9:2]), .wdata(iomem_wdata[5:0])
   );
 
-  wire [11:0] texture_read_address = { tile_read_data[5:0], effective_y[2:0], effective_x[2:0] };
+  wire [11:0] texture_read_address = in_window[1] ? { remapped_tile, window_row_y[2:0], window_col_x[2:0] }
+                                                   : { remapped_tile, effective_y[2:0], effective_x[2:0] };
   texture_memory texturemem(
     .clk(clk),
-    .ren(video_active), .raddr(texture_read_address), .rdata(texture_read_data),
-    .wen(texmem_write), .waddr(iomem_addr[13:2]), .wdata(iomem_wdata[2:0])
+    .ren(video_active), .raddr(texture_read_address[11:3]), .rdata(texture_read_row),
+    .wen(texmem_wen), .waddr(texmem_waddr), .wdata(texmem_wdata)
   );
 
 
-  wire[NUM_SPRITES-1:0] inbb;
-  wire[13:0] sprite_mem_addr[0:NUM_SPRITES-1];
+  // sprite attributes: the CPU writes the shadow copy, which is copied into
+  // the active copy (read by the sprite engine) when the registers latch
+  wire [5:0] attrmem_addr = (iomem_addr[23:20]==4'h4) ? iomem_addr[7:2] : { 2'b0, bank_addr - 4'd2 };
+  wire [31:0] shadow_attr_rdata;
+  wire [31:0] active_attr_rdata;
+  wire [5:0] engine_attr_raddr;
 
-  generate
-    genvar i;
-    /* generate some voices and wire them to the per-MIDI-note gates */
-    for (i=0; i<NUM_SPRITES; i=i+1)
-    begin : sprites
-      sprite sprite (
-        .screen_xpos(next_xpos), .screen_ypos(half_ypos),
-        .configuration(config_register_bank[i+2][31:0]),
-        .in_sprite_bounding_box(inbb[i]),
-        .sprite_mem_addr(sprite_mem_addr[i])
-      );
-    end
-  endgenerate
+  reg attr_copy_busy;
+  reg [5:0] attr_copy_idx;
+  reg attr_copy_wen;
+  reg [5:0] attr_copy_waddr;
+
+  assign cpu_attr_read = attrmem_read && !attr_copy_busy && !read_done;
 
-  localparam CONFIG_R = 26;
-  localparam CONFIG_G = 27;
-  localparam CONFIG_B = 28;
-
-  wire [13:0] sprite_read_address = inbb[0]?sprite_mem_addr[0][13:0]:
-                                  inbb[1]?sprite_mem_addr[1][13:0]:
-                                  inbb[2]?sprite_mem_addr[2][13:0]:
-                                  inbb[3]?sprite_mem_addr[3][13:0]:
-                                  inbb[4]?sprite_mem_addr[4][13:0]:
-                                  inbb[5]?sprite_mem_addr[5][13:0]:
-                                  inbb[6]?sprite_mem_addr[6][13:0]:
-                                  inbb[7]?sprite_mem_addr[7][13:0]:
-                                  14'h0;
-  wire sprite_r = (
-                    inbb[0]?config_register_bank[2][CONFIG_R]
-                    :inbb[1]?config_register_bank[3][CONFIG_R]
-                    :inbb[2]?config_register_bank[4][CONFIG_R]
-                    :inbb[3]?config_register_bank[5][CONFIG_R]
-                    :inbb[4]?config_register_bank[6][CONFIG_R]
-                    :inbb[5]?config_register_bank[7][CONFIG_R]
-                    :inbb[6]?config_register_bank[8][CONFIG_R]
-                    :inbb[7]?config_register_bank[9][CONFIG_R]
-                    :1'b0
-                  );
-  wire sprite_g = (
-                    inbb[0]?config_register_bank[2][CONFIG_G]
-                    :inbb[1]?config_register_bank[3][CONFIG_G]
-                    :inbb[2]?config_register_bank[4][CONFIG_G]
-                    :inbb[3]?config_register_bank[5][CONFIG_G]
-                    :inbb[4]?config_register_bank[6][CONFIG_G]
-                    :inbb[5]?config_register_bank[7][CONFIG_G]
-                    :inbb[6]?config_register_bank[8][CONFIG_G]
-                    :inbb[7]?config_register_bank[9][CONFIG_G]
-                    :1'b0
-                  );
-  wire sprite_b = (
-                    inbb[0]?config_register_bank[2][CONFIG_B]
-                    :inbb[1]?config_register_bank[3][CONFIG_B]
-                    :inbb[2]?config_register_bank[4][CONFIG_B]
-                    :inbb[3]?config_register_bank[5][CONFIG_B]
-                    :inbb[4]?config_register_bank[6][CONFIG_B]
-                    :inbb[5]?config_register_bank[7][CONFIG_B]
-                    :inbb[6]?config_register_bank[8][CONFIG_B]
-                    :inbb[7]?config_register_bank[9][CONFIG_B]
-                    :1'b0
-                  );
-
-  wire sprite_read_data;
+  sprite_attribute_memory shadow_attrmem(
+    .clk(clk),
+    .ren(attr_copy_busy || cpu_attr_read),
+    .raddr(attr_copy_busy ? attr_copy_idx : attrmem_addr), .rdata(shadow_attr_rdata),
+    .wen(attrmem_write ? iomem_wstrb : 4'h0), .waddr(attrmem_addr), .wdata(iomem_wdata)
+  );
+
+  sprite_attribute_memory active_attrmem(
+    .clk(clk),
+    .ren(1'b1), .raddr(engine_attr_raddr), .rdata(active_attr_rdata),
+    .wen({4{attr_copy_wen || copper_attr}}),
+    .waddr(attr_copy_wen ? attr_copy_waddr : copper_target[5:0]),
+    .wdata(attr_copy_wen ? shadow_attr_rdata : copper_value)
+  );
+
+  wire [8:0] sprite_read_address;
+  wire [31:0] sprite_read_row;
+  wire [9:0] sprite_pixel;
+  wire sprite_overflow;
+  wire sprite_overlap;
+  wire [4:0] sprite_overlap_a;
+  wire [4:0] sprite_overlap_b;
 
   sprite_memory spritemem(
     .clk(clk),
-    .ren(video_active), .raddr(sprite_read_address), .rdata(sprite_read_data),
-    .wen(spritemem_write), .waddr(iomem_addr[15:2]), .wdata(iomem_wdata[0])
+    .ren(1'b1), .raddr(sprite_read_address), .rdata(sprite_read_row),
+    .wen(spritemem_wen), .waddr(spritemem_waddr), .wdata(spritemem_wdata)
+  );
+
+  // each 320x240 line is scanned twice; the engine builds the next line
+  // while the current one is on screen (line 0 during the last of vblank)
+  reg hblank_d;
+  wire hblank_start = hblank && !hblank_d;
+
+  // sprite animations step once a frame, after any attribute copy at vblank
+  reg anim_pending;
+  wire anim_advance = anim_pending && !attr_copy_busy;
+
+  always @(posedge clk) begin
+    if (vblank_start) anim_pending <= 1;
+    else if (anim_advance) anim_pending <= 0;
+    if (!resetn) anim_pending <= 0;
+  end
+
+  wire [8:0] sprite_line = line[9:1] + 9'd1;
+
+  sprite_engine #(
+    .NUM_SPRITES(NUM_SPRITES),
+    .MAX_PER_LINE(16)
+  ) sprites (
+    .clk(clk),
+    .resetn(resetn),
+    .start(hblank_start && !line[0] && sprite_line < 240),
+    .advance(anim_advance),
+    .line(sprite_line),
+    .attr_raddr(engine_attr_raddr),
+    .attr_rdata(active_attr_rdata),
+    .spritemem_raddr(sprite_read_address),
+    .spritemem_rdata(sprite_read_row),
+    .xpos(next_xpos),
+    .buffer(half_ypos[0]),
+    .pixel(sprite_pixel),
+    .overflow(sprite_overflow),
+    .overlap(sprite_overlap),
+    .overlap_a(sprite_overlap_a),
+    .overlap_b(sprite_overlap_b)
+  );
+
+  always @(posedge clk) begin
+    if (video_active) begin
+      tile_read_sel <= tile_read_address[1:0];
+      texture_read_sel <= texture_read_address[2:0];
+    end
+  end
+
+  // texels and sprite colours both index the palette, which costs a clock,
+  // so the sync signals are delayed to match
+  wire window_pixel = in_window[2];
+  wire sprite_shown = sprite_pixel[4] && !(window_pixel && window_priority);
+  wire [4:0] colour_index = sprite_shown ? { 1'b1, sprite_pixel[3:0] } : { 1'b0, texture_read_data };
+  wire [17:0] colour;
+
+  wire [4:0] lcd_palette_raddr;
+  wire [4:0] oled_palette_raddr;
+
+  palette_memory palette(
+    .clk(clk),
+    .ren(1'b1), .raddr(LCD ? lcd_palette_raddr : OLED ? oled_palette_raddr : colour_index), .rdata(colour),
+    .wen(palette_write || copper_palette),
+    .waddr(palette_write ? iomem_addr[6:2] : copper_target[4:0]),
+    .wdata(palette_write ? iomem_wdata[17:0] : copper_value[17:0])
   );
 
-  assign vga_r = video_active && ((sprite_read_data && sprite_r) || (!sprite_read_data && texture_read_data[0]));
-  assign vga_g = video_active && ((sprite_read_data && sprite_g) || (!sprite_read_data && texture_read_data[1]));
-  assign vga_b = video_active && ((sprite_read_data && sprite_b) || (!sprite_read_data && texture_read_data[2]));
+  wire raw_hsync;
+  wire raw_vsync;
+  reg colour_active;
+  reg hsync_d;
+  reg vsync_d;
+
+  always @(posedge clk) begin
+    colour_active <= video_active;
+    hsync_d <= raw_hsync;
+    vsync_d <= raw_vsync;
+  end
+
+  // the outputs are 1 bit per channel, so take the top bit of each
+  assign vga_hsync = hsync_d;
+  assign vga_vsync = vsync_d;
+  assign vga_r = colour_active && colour[17];
+  assign vga_g = colour_active && colour[11];
+  assign vga_b = colour_active && colour[5];
+
+  // LCD: the first scan of each line is captured and sent to the panel,
+  // which takes the palette's read port. The lines are made longer so
+  // that a line is sent in the time of two scans.
+  generate
+    if (LCD) begin
+      lcd_scanout scanout(
+        .clk(clk),
+        .resetn(resetn),
+        .frame_start(vblank_start),
+        .capture(video_active && !ypos[0]),
+        .xpos(half_xpos),
+        .index(colour_index),
+        .palette_raddr(lcd_palette_raddr),
+        .palette_rdata(colour),
+        .pix_data(lcd_pix_data),
+        .pix_clk(lcd_pix_clk),
+        .reset_cursor(lcd_reset_cursor),
+        .frame_sync(lcd_frame_sync),
+        .busy(lcd_busy)
+      );
+    end else begin
+      assign lcd_palette_raddr = 5'h0;
+      assign lcd_pix_data = 16'h0;
+      assign lcd_pix_clk = 1'b0;
+      assign lcd_reset_cursor = 1'b0;
+      assign lcd_frame_sync = 1'b0;
+    end
+
+    // OLED: the display is 128x128, and the lines are long enough for a
+    // line to be sent over SPI at 8MHz in the time of its two scans
+    if (OLED) begin
+      oled_scanout oled_scan(
+        .clk(clk),
+        .resetn(resetn),
+        .scan(video_active && !ypos[0]),
+        .line(half_ypos[6:0]),
+        .xpos(half_xpos[6:0]),
+        .index(colour_index),
+        .palette_raddr(oled_palette_raddr),
+        .palette_rdata(colour),
+        .stream_valid(oled_valid),
+        .stream_data(oled_data),
+        .stream_dc(oled_dc),
+        .stream_ready(oled_ready)
+      );
+    end else begin
+      assign oled_palette_raddr = 5'h0;
+      assign oled_valid = 1'b0;
+      assign oled_data = 8'h0;
+      assign oled_dc = 1'b0;
+    end
+  endgenerate
 
 	always @(posedge clk) begin
-		if (iomem_valid && reg_write) begin
+		if (iomem_valid && bank_write) begin
 			if (iomem_wstrb[0]) config_register_bank[bank_addr][ 7: 0] <= iomem_wdata[ 7: 0];
 			if (iomem_wstrb[1]) config_register_bank[bank_addr][15: 8] <= iomem_wdata[15: 8];
 			if (iomem_wstrb[2]) config_register_bank[bank_addr][23:16] <= iomem_wdata[23:16];
@@ -159,24 +522,231 @@ module video
     if (!resetn) begin
       config_register_bank[0]<=32'h0;
       config_register_bank[1]<=32'h0;
-      config_register_bank[2]<=32'h0;
-      config_register_bank[3]<=32'h0;
-      config_register_bank[4]<=32'h0;
-      config_register_bank[5]<=32'h0;
-      config_register_bank[6]<=32'h0;
-      config_register_bank[7]<=32'h0;
-      config_register_bank[8]<=32'h0;
-      config_register_bank[9]<=32'h0;
     end
 	end
 
-  VGASyncGen vga_generator(
+  // shadow -> active bank latching
+  // every vblank when auto latch is on, otherwise only at the vblank after a
+  // commit, or straight away for a commit with bit 0 set
+  reg bank_auto_latch;
+  reg bank_commit_pending;
+  reg [1:0] config_tile_page;
+  wire bank_commit_now = ctrl_write && ctrl_addr == 6'h6 && iomem_wdata[0];
+  wire bank_latch = bank_commit_now || (vblank_start && (bank_auto_latch || bank_commit_pending));
+
+  integer r;
+  always @(posedge clk) begin
+    if (ctrl_write && ctrl_addr == 6'h5) bank_auto_latch <= iomem_wdata[0];
+    if (ctrl_write && ctrl_addr == 6'h6 && !iomem_wdata[0]) bank_commit_pending <= 1;
+    if (ctrl_write && ctrl_addr == 6'he) config_tile_page <= iomem_wdata[1:0];
+    if (copper_scroll) active_register_bank[copper_target[0]] <= copper_value;
+    if (bank_latch) begin
+      bank_commit_pending <= 0;
+      for (r = 0; r < 2; r = r + 1)
+        active_register_bank[r] <= config_register_bank[r];
+      { tile_page, tile_page_mode } <= config_tile_page;
+    end
+    if (!resetn) begin
+      bank_auto_latch <= 1;
+      bank_commit_pending <= 0;
+      config_tile_page <= 0;
+      tile_page_mode <= 0;
+      tile_page <= 0;
+      for (r = 0; r < 2; r = r + 1)
+        active_register_bank[r] <= 32'h0;
+    end
+  end
+
+  assign copper_stall = (copper_target[7:5] == 3'b000 && ctrl_write) ||
+                        (copper_target[7:5] == 3'b001 && palette_write) ||
+                        (copper_target[7:6] == 2'b01 && (attr_copy_busy || attr_copy_wen));
+
+  // the sprite attributes take a clock per word to copy across
+  always @(posedge clk) begin
+    attr_copy_wen <= 0;
+    if (bank_latch) begin
+      attr_copy_busy <= 1;
+      attr_copy_idx <= 0;
+    end else if (attr_copy_busy) begin
+      attr_copy_wen <= 1;
+      attr_copy_waddr <= attr_copy_idx;
+      attr_copy_idx <= attr_copy_idx + 1;
+      if (attr_copy_idx == 2*NUM_SPRITES-1) attr_copy_busy <= 0;
+    end
+    if (!resetn) attr_copy_busy <= 0;
+  end
+
+  // control/status registers (0x0500_0040 onwards)
+  // 0: irq pending (write 1s to acknowledge)
+  // 1: irq enable
+  // 2: frame counter (read only)
+  // 3: line compare, raises IRQ_LINE as the beam starts that (320x240) line
+  // 4: beam position (read only) - 17: vblank, 16: hblank, 8-0: current line
+  // 5: register bank control - 0: latch shadow registers every vblank
+  // 6: commit (write only) - latch shadow registers at next vblank, or now if bit 0 set
+  // 7: vram address for the data port
+  // 8: vram data port (write only)
+  // 9: sprite-sprite collisions in the last frame (read only), one bit per sprite
+  // 10: sprite-background collisions in the last frame (read only)
+  // 11: tile remap control - 1-0: bank, 3-2: last bank, 4: auto advance, 11-8: vblanks per step - 1
+  // 12: window - 31: enable, 30: in front of sprites, 24-16: top, 8-0: left
+  // 13: line scroll control - 0: add the line scroll table to the x offset
+  // 14: tile pages (shadowed) - 0: page mode, 1: page shown
+  // 15: tile fill command (see above), reads back 31: busy
+  // 16: copper control - 0: run the display list every frame
+
+  localparam IRQ_VBLANK = 0;
+  localparam IRQ_LINE = 1;
+  localparam IRQ_SPRITE_OVERFLOW = 2;
+
+  reg [7:0] irq_pending;
+  reg [7:0] irq_enable;
+  reg [15:0] frame_count;
+  reg [8:0] line_compare;
+
+  // collisions are gathered over a frame, then latched and cleared at vblank
+  reg [NUM_SPRITES-1:0] sprite_hits;
+  reg [NUM_SPRITES-1:0] background_hits;
+  reg [NUM_SPRITES-1:0] sprite_hits_acc;
+  reg [NUM_SPRITES-1:0] background_hits_acc;
+
+  // a sprite pixel over a non-zero texel, both as displayed
+  wire background_hit = video_active && sprite_pixel[4] && !window_pixel && texture_read_data != 0;
+
+  // each 320x240 line is scanned twice, so only match on the first one
+  wire line_match = hblank_start && !vblank && !line[0] && (line[9:1] == line_compare);
+
+  assign irq = |(irq_pending & irq_enable);
+
+  always @(posedge clk) begin
+    if (ctrl_write && ctrl_addr == 6'h0) irq_pending <= irq_pending & ~iomem_wdata[7:0];
+    if (ctrl_write && ctrl_addr == 6'h1) irq_enable <= iomem_wdata[7:0];
+    if (ctrl_write && ctrl_addr == 6'h3) line_compare <= iomem_wdata[8:0];
+    hblank_d <= hblank;
+    if (line_match) irq_pending[IRQ_LINE] <= 1;
+    if (sprite_overflow) irq_pending[IRQ_SPRITE_OVERFLOW] <= 1;
+    if (remap_reg_write) begin
+      remap_bank <= reg_wdata[1:0];
+      remap_last_bank <= reg_wdata[3:2];
+      remap_auto <= reg_wdata[4];
+      remap_rate <= reg_wdata[11:8];
+      remap_tick <= 0;
+    end else if (vblank_start && remap_auto) begin
+      if (remap_tick >= remap_rate) begin
+        remap_tick <= 0;
+        remap_bank <= (remap_bank >= remap_last_bank) ? 2'd0 : remap_bank + 1;
+      end else begin
+        remap_tick <= remap_tick + 1;
+      end
+    end
+    if (window_reg_write) begin
+      window_enable <= reg_wdata[31];
+      window_priority <= reg_wdata[30];
+      window_y <= reg_wdata[24:16];
+      window_x <= reg_wdata[8:0];
+    end
+    if (line_scroll_reg_write) line_scroll_enable <= reg_wdata[0];
+    if (ctrl_write && ctrl_addr == 6'h10) copper_enable <= iomem_wdata[0];
+    if (sprite_overlap) begin
+      sprite_hits_acc[sprite_overlap_a] <= 1;
+      sprite_hits_acc[sprite_overlap_b] <= 1;
+    end
+    if (background_hit) background_hits_acc[sprite_pixel[9:5]] <= 1;
+    if (vblank_start) begin
+      irq_pending[IRQ_VBLANK] <= 1;
+      frame_count <= frame_count + 1;
+      sprite_hits <= sprite_hits_acc;
+      background_hits <= background_hits_acc;
+      sprite_hits_acc <= 0;
+      background_hits_acc <= 0;
+    end
+    if (!resetn) begin
+      irq_pending <= 8'h0;
+      irq_enable <= 8'h0;
+      frame_count <= 16'h0;
+      line_compare <= 9'h0;
+      remap_bank <= 0;
+      remap_last_bank <= 0;
+      remap_auto <= 0;
+      remap_rate <= 0;
+      remap_tick <= 0;
+      window_enable <= 0;
+      window_priority <= 0;
+      window_x <= 0;
+      window_y <= 0;
+      line_scroll_enable <= 0;
+      copper_enable <= 0;
+      sprite_hits <= 0;
+      background_hits <= 0;
+      sprite_hits_acc <= 0;
+      background_hits_acc <= 0;
+    end
+  end
+
+`ifdef FORMAL
+  // a tile remap control write, from the CPU or the copper, leaves the
+  // window, line scroll and copper registers alone
+  reg past_valid = 0;
+  reg past_remap_only;
+  reg [21:0] past_ctrl;
+  wire [21:0] other_ctrl = { window_enable, window_priority, window_y, window_x,
+                             line_scroll_enable, copper_enable };
+
+  always @(posedge clk) begin
+    past_valid <= 1;
+    past_remap_only <= resetn && remap_reg_write && !window_reg_write &&
+                       !line_scroll_reg_write && !(ctrl_write && ctrl_addr == 6'h10);
+    past_ctrl <= other_ctrl;
+    if (past_valid && past_remap_only)
+      assert(other_ctrl == past_ctrl);
+  end
+`endif
+
+  always @(*) begin
+    iomem_rdata = 32'h0;
+    if (tilemem_read)
+      iomem_rdata = packed_write ? tile_read_row : tile_read_row[iomem_addr[3:2]*6 +: 6];
+    else if (attrmem_read)
+      iomem_rdata = shadow_attr_rdata;
+    else if (bank_sel && bank_addr < 2)
+      iomem_rdata = config_register_bank[bank_addr[0]];
+    else if (ctrl_sel) begin
+      case (ctrl_addr)
+        6'h0: iomem_rdata = irq_pending;
+        6'h1: iomem_rdata = irq_enable;
+        6'h2: iomem_rdata = frame_count;
+        6'h3: iomem_rdata = line_compare;
+        6'h4: iomem_rdata = { vblank, hblank, 7'h0, vblank ? 9'h0 : line[9:1] };
+        6'h5: iomem_rdata = { bank_commit_pending, bank_auto_latch };
+        6'h7: iomem_rdata = vram_addr;
+        6'h9: iomem_rdata = sprite_hits;
+        6'ha: iomem_rdata = background_hits;
+        6'hb: iomem_rdata = { remap_rate, 3'h0, remap_auto, remap_last_bank, remap_bank };
+        6'hc: iomem_rdata = { window_enable, window_priority, 5'h0, window_y, 7'h0, window_x };
+        6'hd: iomem_rdata = line_scroll_enable;
+        6'he: iomem_rdata = config_tile_page;
+        6'hf: iomem_rdata = { fill_busy, fill_dropped, 30'h0 };
+        6'h10: iomem_rdata = copper_enable;
+        6'h11: iomem_rdata = { fill_dropped, fill_busy, attr_copy_busy, bank_commit_pending, video_active, hblank, vblank };
+      endcase
+    end
+  end
+
+  VGASyncGen #(
+    .activeHvideo(OLED ? 128 : 320),
+    .activeVvideo(OLED ? 256 : 480),
+    .hbp(LCD ? 300 : OLED ? 2026 : 61)
+  ) vga_generator(
     .clk(clk),
-    .hsync(vga_hsync),
-    .vsync(vga_vsync),
+    .hsync(raw_hsync),
+    .vsync(raw_vsync),
     .x_px(xpos),
     .y_px(ypos),
-    .activevideo(video_active)
+    .activevideo(video_active),
+    .endframe(vblank_start),
+    .hblank(hblank),
+    .vblank(vblank),
+    .line(line)
   );
 
 endmodule
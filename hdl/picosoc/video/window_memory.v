@@ -0,0 +1,20 @@
+// 2 BRAMS
+// window tile map, stored as 256 groups of 4 tile indices (tile x in bits
+// 6x+5:6x) like tile_memory, with a write enable per tile
+module window_memory (
+    input clk, ren,
+    input [3:0] wen,
+    input [7:0] waddr, raddr,
+    input [23:0] wdata,
+    output reg [23:0] rdata
+);
+    reg [23:0] mem [0:255];   // 32x32 map of tiles
+    integer i;
+    always @(posedge clk) begin
+      if (ren)
+        rdata <= mem[raddr];
+      for (i = 0; i < 4; i = i + 1)
+        if (wen[i])
+          mem[waddr][i*6 +: 6] <= wdata[i*6 +: 6];
+    end
+endmodule
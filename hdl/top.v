@@ -147,6 +147,7 @@ module top (
 `endif
 
 `ifdef oled
+        wire oled_irq;
         reg spi_wr, spi_rd;
 	reg [31:0] spi_rdata;
 	reg spi_ready;
@@ -159,6 +160,11 @@ module top (
             .ctrl_wdat(iomem_wdata),
             .ctrl_rdat(spi_rdata),
             .ctrl_done(spi_ready),
+            .stream_valid(1'b0),
+            .stream_data(8'h0),
+            .stream_dc(1'b0),
+            .stream_ready(),
+            .irq(oled_irq),
             .mosi(OLED_SPI_SDA),
             .sclk(OLED_SPI_SCL),
             .cs(OLED_SPI_CS),
@@ -251,11 +257,13 @@ module top (
 `ifdef oled
             spi_wr <= 0;
             spi_rd <= 0;
+            // hold the request until the device is done, and only once,
+            // so that each store queues its bytes exactly once
             if (iomem_valid && !iomem_ready && iomem_addr[31:24] == 8'h05) begin
                  iomem_ready <= spi_ready;
                  iomem_rdata <= spi_rdata;
-                 spi_wr <= |iomem_wstrb;
-                 spi_rd <= ~(|iomem_wstrb);
+                 spi_wr <= |iomem_wstrb && !spi_ready;
+                 spi_rd <= ~(|iomem_wstrb) && !spi_ready;
             end
 `endif
 
@@ -322,7 +330,11 @@ module top (
         .flash_io2_di (flash_io2_di),
         .flash_io3_di (flash_io3_di),
 
+`ifdef oled
+        .irq_5        (oled_irq    ),
+`else
         .irq_5        (1'b0        ),
+`endif
         .irq_6        (1'b0        ),
         .irq_7        (1'b0        ),
 
@@ -331,6 +343,11 @@ module top (
         .iomem_wstrb  (iomem_wstrb ),
         .iomem_addr   (iomem_addr  ),
         .iomem_wdata  (iomem_wdata ),
-        .iomem_rdata  (iomem_rdata )
+        .iomem_rdata  (iomem_rdata ),
+
+        .dma_valid    (1'b0        ),
+        .dma_wstrb    (4'b0        ),
+        .dma_addr     (32'h0       ),
+        .dma_wdata    (32'h0       )
     );
 endmodule
@@ -0,0 +1,30 @@
+#include "dma.h"
+
+// copies words from src to dst in the background, moving each address on by
+// src_inc/dst_inc bytes per word (0 to keep writing to the same register)
+void dma_start(const void *src, volatile void *dst, uint32_t words,
+               uint32_t src_inc, uint32_t dst_inc, uint32_t irq)
+{
+  dma_wait();
+  reg_dma_src = (uint32_t)src;
+  reg_dma_dst = (uint32_t)dst;
+  reg_dma_count = words;
+  reg_dma_inc = (dst_inc << 16) | (src_inc & 0xffff);
+  reg_dma_ctrl = DMA_START | (irq ? DMA_IRQ_ENABLE : 0);
+}
+
+uint32_t dma_busy()
+{
+  return reg_dma_ctrl & DMA_BUSY;
+}
+
+void dma_wait()
+{
+  while (reg_dma_ctrl & DMA_BUSY);
+}
+
+// call from irq_handler when IRQ 6 fires
+void dma_ack_irq()
+{
+  reg_dma_ctrl = (reg_dma_ctrl & DMA_IRQ_ENABLE) | DMA_DONE;
+}
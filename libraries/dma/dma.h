@@ -0,0 +1,28 @@
+/*
+ * DMA controller related functions
+ */
+
+#ifndef __TINYSOC_DMA__
+#define __TINYSOC_DMA__
+
+#include <stdint.h>
+
+#define reg_dma_src    (*(volatile uint32_t*)0x08000000)
+#define reg_dma_dst    (*(volatile uint32_t*)0x08000004)
+#define reg_dma_count  (*(volatile uint32_t*)0x08000008)
+#define reg_dma_inc    (*(volatile uint32_t*)0x0800000c)
+#define reg_dma_ctrl   (*(volatile uint32_t*)0x08000010)
+
+// control/status bits (the dma controller raises CPU IRQ 6 when done)
+#define DMA_START      0x01
+#define DMA_BUSY       0x01
+#define DMA_IRQ_ENABLE 0x02
+#define DMA_DONE       0x04
+
+void dma_start(const void *src, volatile void *dst, uint32_t words,
+               uint32_t src_inc, uint32_t dst_inc, uint32_t irq);
+uint32_t dma_busy();
+void dma_wait();
+void dma_ack_irq();
+
+#endif
@@ -1,46 +1,107 @@
 #include "video.h"
 
-struct sprite_config_reg_t sprite_state[4];
+// in firmware/start.S
+uint32_t picorv32_waitirq();
+uint32_t picorv32_maskirq(uint32_t mask);
+
+// the tile writers add this to y, to draw into a hidden tile page
+static uint32_t draw_page_row;
+static uint32_t tile_page_ctrl;
+
+// the two packed attribute words of every sprite, as last written. The
+// setters change their fields here and write the word out, so they never
+// wait on the attribute memory's read port; only vid_get_sprite_config()
+// reads it. Nothing is shown until the registers latch at vblank.
+static uint32_t sprite_words[2*VID_NUM_SPRITES];
+
+static void sprite_update(uint32_t word, uint32_t mask, uint32_t value)
+{
+  uint32_t w = (sprite_words[word] & ~mask) | (value & mask);
+  sprite_words[word] = w;
+  reg_video_spriteconfig[word] = w;
+}
 
 void vid_init()
 {
-  for (int i=0; i<4; i++) {
-    sprite_state[i].enable = 0;
-    vid_set_all_sprite_config(i, &sprite_state[i]);
+  for (int i=0; i<2*VID_NUM_SPRITES; i++) {
+    sprite_words[i] = 0;
+    reg_video_spriteconfig[i] = 0;
   }
 }
 
 void vid_enable_sprite(uint32_t sprite_num, uint32_t enable)
 {
-  sprite_state[sprite_num].enable = enable&0x01;
-  vid_set_all_sprite_config(sprite_num, &sprite_state[sprite_num]);
+  sprite_update(sprite_num, 0x20000000, enable << 29);
 }
 
 void vid_set_image_for_sprite(uint32_t sprite_num, uint32_t image_num)
 {
-    sprite_state[sprite_num].image = image_num & 0x3f;
-    vid_set_all_sprite_config(sprite_num, &sprite_state[sprite_num]);
+    sprite_update(sprite_num, 0x03f00000, image_num << 20);
 }
 
 void vid_set_sprite_pos(uint32_t sprite_num, uint32_t x, uint32_t y) {
-  sprite_state[sprite_num].xpos = x & 1023;
-  sprite_state[sprite_num].ypos = y & 1023;
-  vid_set_all_sprite_config(sprite_num, &sprite_state[sprite_num]);
+  sprite_update(sprite_num, 0x000fffff, ((x & 1023) << 10) | (y & 1023));
 }
 
 void vid_set_all_sprite_config(uint32_t sprite_num, struct sprite_config_reg_t *sprite_config) {
-  uint32_t out = (sprite_config->enable << 29)
+  sprite_update(sprite_num, 0xffffffff,
+                  (sprite_config->enable << 29)
                   | (sprite_config->colour << 26)
                   | (sprite_config->image << 20)
                   | (sprite_config->xpos << 10)
-                  | (sprite_config->ypos);
-  reg_video_spriteconfig[sprite_num]=out;
+                  | (sprite_config->ypos));
+  sprite_update(VID_NUM_SPRITES + sprite_num, 0xffffffff,
+                  sprite_config->flags
+                  | (sprite_config->palette << 4)
+                  | (sprite_config->frames << 8)
+                  | (sprite_config->rate << 12));
 };
 
+// reads the attribute memory itself, and takes what it finds as the copy
+// the setters work from, so a sprite changed by the copper can be picked up
+void vid_get_sprite_config(uint32_t sprite_num, struct sprite_config_reg_t *sprite_config)
+{
+  uint32_t attr = reg_video_spriteconfig[sprite_num];
+  uint32_t flags = reg_video_spriteconfig[VID_NUM_SPRITES + sprite_num];
+  sprite_words[sprite_num] = attr;
+  sprite_words[VID_NUM_SPRITES + sprite_num] = flags;
+  sprite_config->enable = (attr >> 29) & 0x01;
+  sprite_config->colour = (attr >> 26) & 0x07;
+  sprite_config->image = (attr >> 20) & 0x3f;
+  sprite_config->xpos = (attr >> 10) & 1023;
+  sprite_config->ypos = attr & 1023;
+  sprite_config->flags = flags & 0x07;
+  sprite_config->palette = (flags >> 4) & 0x03;
+  sprite_config->frames = (flags >> 8) & 0x0f;
+  sprite_config->rate = (flags >> 12) & 0x0f;
+}
+
 void vid_set_sprite_colour(uint32_t sprite_num, uint32_t sprite_colour)
 {
-  sprite_state[sprite_num].colour = sprite_colour & 0x07;
-  vid_set_all_sprite_config(sprite_num, &sprite_state[sprite_num]);
+  sprite_update(sprite_num, 0x1c000000, sprite_colour << 26);
+}
+
+void vid_set_sprite_flip(uint32_t sprite_num, uint32_t hflip, uint32_t vflip)
+{
+  uint32_t flags = 0;
+  if (hflip) flags |= VID_SPRITE_HFLIP;
+  if (vflip) flags |= VID_SPRITE_VFLIP;
+  sprite_update(VID_NUM_SPRITES + sprite_num, VID_SPRITE_HFLIP | VID_SPRITE_VFLIP, flags);
+}
+
+void vid_set_sprite_2bpp(uint32_t sprite_num, uint32_t enable, uint32_t palette)
+{
+  sprite_update(VID_NUM_SPRITES + sprite_num, VID_SPRITE_2BPP | 0x30,
+                (enable ? VID_SPRITE_2BPP : 0) | (palette << 4));
+}
+
+// the video hardware steps through frames images from the sprite's image
+// (two image numbers apart for 2bpp), showing each for vblanks_per_frame
+// vblanks; frames = 1 stops the animation
+void vid_set_sprite_anim(uint32_t sprite_num, uint32_t frames, uint32_t vblanks_per_frame)
+{
+  sprite_update(VID_NUM_SPRITES + sprite_num, 0xff00,
+                (((frames - 1) & 0x0f) << 8) | (((vblanks_per_frame - 1) & 0x0f) << 12));
 }
 
 void vid_random_init_sprite_memory()
@@ -52,14 +113,25 @@ void vid_random_init_sprite_memory()
 
 void vid_write_sprite_memory(uint32_t image_num, const uint32_t *data)
 {
-  for (int y = 0; y<16; y++) {
-    uint32_t rowdata = data[y];
-    for (int x = 0; x<16; x++) {
-      int memaddr = (image_num << 8) + (y << 4) + x;
-      uint32_t sprite_pixel = ((rowdata & 0x8000) == 0x8000) ? 1 : 0;
-      reg_video_spritemem[memaddr] = sprite_pixel;
-      rowdata = (rowdata & 0x7fff) << 1;
-    }
+  vid_upload_sprite(image_num, data);
+}
+
+// data is 16 rows of 16 pixels, leftmost pixel in bit 15
+void vid_upload_sprite(uint32_t image_num, const uint32_t *data)
+{
+  volatile uint32_t *dest = &reg_video_spritemem_packed[image_num << 3];
+  for (int y = 0; y < 16; y += 2) {
+    *dest++ = (data[y] << 16) | (data[y+1] & 0xffff);
+  }
+}
+
+// data is 16 rows of 16 2 bit pixels, leftmost pixel in bits 31-30
+// the image takes two image numbers (image_num and image_num + 1)
+void vid_upload_sprite_2bpp(uint32_t image_num, const uint32_t *data)
+{
+  volatile uint32_t *dest = &reg_video_spritemem_packed[image_num << 3];
+  for (int y = 0; y < 16; y++) {
+    *dest++ = data[y];
   }
 }
 
@@ -68,20 +140,341 @@ void vid_set_texture_pixel(uint32_t texnum, uint32_t x, uint32_t y, uint32_t pix
   reg_video_texmem[(texnum << 6) + (y << 3) + x] = pixel;
 }
 
+// packs 8 texels into one row write, first texel in the low bits
+static uint32_t pack_texture_row(const uint8_t *texels)
+{
+  uint32_t row = 0;
+  for (int x = 7; x >= 0; x--) {
+    row = (row << 4) | (texels[x] & 0x0f);
+  }
+  return row;
+}
+
 void vid_set_texture(uint32_t texnum, const uint32_t *data)
 {
-  int ofs = 0;
+  volatile uint32_t *dest = &reg_video_texmem_packed[texnum << 3];
   for (int y = 0; y < 8; y++) {
-    for (int x = 0; x < 8; x++) {
-      reg_video_texmem[texnum<<6 + ofs] = data[ofs];
-      ++ofs;
+    uint32_t row = 0;
+    for (int x = 7; x >= 0; x--) {
+      row = (row << 4) | (data[x] & 0x0f);
+    }
+    *dest++ = row;
+    data += 8;
+  }
+}
+
+// the window covers the screen from (x, y) to the bottom right, with its
+// own 32x32 tile map that does not scroll; flags are VID_WINDOW_*
+void vid_set_window(uint32_t x, uint32_t y, uint32_t flags)
+{
+  reg_video_window = flags | ((y & 0x1ff) << 16) | (x & 0x1ff);
+}
+
+void vid_set_window_tile(uint32_t x, uint32_t y, uint32_t texture)
+{
+  reg_video_windowmem[(y<<5)+x] = texture;
+}
+
+void vid_fill_window_row(uint32_t x, uint32_t y, uint32_t w, uint32_t texture)
+{
+  reg_video_vram_addr = VID_VRAM_WINDOW | ((y<<5)+x);
+  while (w--) {
+    reg_video_vram_data = texture;
+  }
+}
+
+void vid_copy_window_row(uint32_t x, uint32_t y, uint32_t w, const uint8_t *tiles)
+{
+  reg_video_vram_addr = VID_VRAM_WINDOW | ((y<<5)+x);
+  while (w--) {
+    reg_video_vram_data = *tiles++;
+  }
+}
+
+// the texture drawn for a tile number, in one of the 4 remap banks
+void vid_set_tile_remap(uint32_t bank, uint32_t tile, uint32_t texture)
+{
+  reg_video_tile_remap[(bank << 6) + tile] = texture;
+}
+
+// show one remap bank (and stop any auto advance)
+void vid_set_remap_bank(uint32_t bank)
+{
+  reg_video_remap_ctrl = bank & VID_REMAP_BANK;
+}
+
+// cycle through remap banks 0..banks-1, moving on every vblanks_per_step vblanks
+void vid_set_remap_auto(uint32_t banks, uint32_t vblanks_per_step)
+{
+  reg_video_remap_ctrl = (((banks - 1) << 2) & VID_REMAP_LAST_BANK)
+                         | VID_REMAP_AUTO
+                         | (((vblanks_per_step - 1) & 0x0f) << 8);
+}
+
+// sheet is 64x64 texels, one per byte, holding the 64 textures 8 to a row
+void vid_upload_texture_sheet(const uint8_t *sheet)
+{
+  volatile uint32_t *dest = reg_video_texmem_packed;
+  for (int texrow = 0; texrow < 8; texrow++) {
+    for (int texcol = 0; texcol < 8; texcol++) {
+      const uint8_t *src = sheet + (texrow << 9) + (texcol << 3);
+      for (int y = 0; y < 8; y++) {
+        *dest++ = pack_texture_row(src);
+        src += 64;
+      }
     }
   }
 }
 
 void vid_set_tile(uint32_t x, uint32_t y, uint32_t texture)
 {
-  reg_video_tilemem[(y<<6)+x]=texture;
+  reg_video_tilemem[((y+draw_page_row)<<6)+x]=texture;
+}
+
+// reads wait for the next blanking interval, up to a line
+uint32_t vid_get_tile(uint32_t x, uint32_t y)
+{
+  return reg_video_tilemem[((y+draw_page_row)<<6)+x];
+}
+
+// the tile helpers below use the vram data port, which moves on to the next
+// tile (or the tile below, with VID_VRAM_STRIDE_64) after every write
+
+void vid_fill_tile_row(uint32_t x, uint32_t y, uint32_t w, uint32_t texture)
+{
+  reg_video_vram_addr = VID_VRAM_TILE | (((y+draw_page_row)<<6)+x);
+  while (w--) {
+    reg_video_vram_data = texture;
+  }
+}
+
+void vid_copy_tile_row(uint32_t x, uint32_t y, uint32_t w, const uint8_t *tiles)
+{
+  reg_video_vram_addr = VID_VRAM_TILE | (((y+draw_page_row)<<6)+x);
+  while (w--) {
+    reg_video_vram_data = *tiles++;
+  }
+}
+
+// one command to the tile fill engine, which writes 4 tiles per clock by
+// itself; w and h are clamped to 64, and an empty rectangle does nothing.
+// In page mode it stops at the bottom of the draw page rather than
+// wrapping into the page on show.
+void vid_fill_tile_rect(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint32_t texture)
+{
+  if (!w || !h) return;
+  if (w > 64) w = 64;
+  if (h > 64) h = 64;
+  if (tile_page_ctrl & VID_PAGE_MODE) {
+    if (y >= 32) return;
+    if (h > 32 - y) h = 32 - y;
+  }
+  vid_wait_tile_fill();
+  reg_video_tile_fill = ((texture & 0x3f) << 24)
+                        | (((h - 1) & 0x3f) << 18)
+                        | (((w - 1) & 0x3f) << 12)
+                        | (((y + draw_page_row) & 0x3f) << 6)
+                        | (x & 0x3f);
+}
+
+// a fill is done in at most 1024 clocks, but tiles written while it runs
+// may be overwritten by it
+void vid_wait_tile_fill()
+{
+  while (reg_video_tile_fill & VID_TILE_FILL_BUSY);
+}
+
+// tiles is a w x h block of tile indices, stride bytes from one row to the next
+void vid_copy_tile_rect(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t *tiles, uint32_t stride)
+{
+  for (uint32_t j = 0; j < h; j++) {
+    vid_copy_tile_row(x, y+j, w, tiles);
+    tiles += stride;
+  }
+}
+
+// copies a width x height map (one tile per byte) to the top left of the
+// tile memory, 4 tiles per write.  width must be a multiple of 4.
+void vid_upload_tilemap(const uint8_t *map, uint32_t width, uint32_t height)
+{
+  volatile uint32_t *dest = &reg_video_tilemem_packed[draw_page_row << 4];
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x += 4) {
+      dest[x >> 2] = (map[x+3] << 18) | (map[x+2] << 12) | (map[x+1] << 6) | map[x];
+    }
+    map += width;
+    dest += 16;
+  }
+}
+
+// list is pairs of words (VID_COPPER_WAIT(line, target), value), in line
+// order, up to 128 entries
+void vid_set_copper_list(const uint32_t *list, uint32_t words)
+{
+  volatile uint32_t *dest = reg_video_copper_list;
+  while (words--) {
+    *dest++ = *list++;
+  }
+}
+
+// the list runs from the top of every frame while enabled
+void vid_enable_copper(uint32_t enable)
+{
+  reg_video_copper_ctrl = enable & 0x01;
+}
+
+// page mode splits the tile memory into two 64x32 pages (rows 0-31 and
+// 32-63), one shown while the other is drawn
+void vid_set_page_mode(uint32_t enable)
+{
+  tile_page_ctrl = (tile_page_ctrl & VID_PAGE_SHOW_1) | (enable ? VID_PAGE_MODE : 0);
+  reg_video_tile_page = tile_page_ctrl;
+}
+
+// shown from the next register latch (normally the next vblank), so a page
+// drawn off screen appears all at once
+void vid_show_page(uint32_t page)
+{
+  tile_page_ctrl = (tile_page_ctrl & VID_PAGE_MODE) | (page ? VID_PAGE_SHOW_1 : 0);
+  reg_video_tile_page = tile_page_ctrl;
+}
+
+// the page that vid_set_tile() and the other tile writers write to
+void vid_set_draw_page(uint32_t page)
+{
+  draw_page_row = page ? 32 : 0;
+}
+
+// the view is the 40x30 tiles of the screen plus one for a part scrolled
+// tile; it sits in the 64x64 tile memory at (col & 63, row & 63) onwards,
+// wrapping round like the scroll offsets do
+#define VIEW_COLS 41
+#define VIEW_ROWS 31
+
+// the world addresses the whole tile memory itself, so rows and columns
+// both ignore the draw page
+static void world_copy(uint32_t addr, const uint8_t *src, uint32_t n)
+{
+  reg_video_vram_addr = VID_VRAM_TILE | addr;
+  while (n--) {
+    reg_video_vram_data = *src++;
+  }
+}
+
+// (no multiply on this core, so map rows are found by stepping row_map)
+static void world_load_row(struct vid_world_t *world, uint32_t r)
+{
+  if (r >= world->height) return;
+  const uint8_t *src = world->row_map + world->col;
+  for (uint32_t i = world->row; i < r; i++) src += world->width;
+
+  uint32_t n = world->width - world->col;
+  if (n > VIEW_COLS) n = VIEW_COLS;
+  uint32_t x = world->col & 63;
+  uint32_t first = 64 - x;
+  if (first > n) first = n;
+  world_copy(((r & 63) << 6) + x, src, first);
+  if (n > first) world_copy((r & 63) << 6, src + first, n - first);
+}
+
+// the 64 stride wraps round the bottom of the tile memory by itself
+static void world_load_column(struct vid_world_t *world, uint32_t c)
+{
+  if (c >= world->width) return;
+  const uint8_t *src = world->row_map + c;
+
+  uint32_t n = world->height - world->row;
+  if (n > VIEW_ROWS) n = VIEW_ROWS;
+  reg_video_vram_addr = VID_VRAM_TILE | VID_VRAM_STRIDE_64 | (((world->row & 63) << 6) + (c & 63));
+  while (n--) {
+    reg_video_vram_data = *src;
+    src += world->width;
+  }
+}
+
+static void world_load_view(struct vid_world_t *world)
+{
+  for (uint32_t r = world->row; r < world->row + VIEW_ROWS; r++) {
+    world_load_row(world, r);
+  }
+}
+
+static void world_scroll(struct vid_world_t *world, uint32_t x, uint32_t y, uint32_t reload)
+{
+  uint32_t max_x = (world->width << 3) - 320;
+  uint32_t max_y = (world->height << 3) - 240;
+  if (x > max_x) x = max_x;
+  if (y > max_y) y = max_y;
+
+  uint32_t col = x >> 3;
+  uint32_t row = y >> 3;
+
+  if (reload ||
+      col + VIEW_COLS < world->col || world->col + VIEW_COLS < col ||
+      row + VIEW_ROWS < world->row || world->row + VIEW_ROWS < row) {
+    while (world->row < row) { world->row++; world->row_map += world->width; }
+    while (world->row > row) { world->row--; world->row_map -= world->width; }
+    world->col = col;
+    world_load_view(world);
+  } else {
+    // new rows are loaded for the old columns, then new columns for the new rows
+    while (world->row < row) {
+      world->row++;
+      world->row_map += world->width;
+      world_load_row(world, world->row + VIEW_ROWS - 1);
+    }
+    while (world->row > row) {
+      world->row--;
+      world->row_map -= world->width;
+      world_load_row(world, world->row);
+    }
+    while (world->col < col) {
+      world->col++;
+      world_load_column(world, world->col + VIEW_COLS - 1);
+    }
+    while (world->col > col) {
+      world->col--;
+      world_load_column(world, world->col);
+    }
+  }
+
+  vid_set_x_ofs(x & 511);
+  vid_set_y_ofs(y & 511);
+}
+
+// loads the whole view at pixel position (x, y) and scrolls to it
+void vid_world_init(struct vid_world_t *world, const uint8_t *map, uint32_t width, uint32_t height, uint32_t x, uint32_t y)
+{
+  world->map = map;
+  world->width = width;
+  world->height = height;
+  world->col = 0;
+  world->row = 0;
+  world->row_map = map;
+  world_scroll(world, x, y, 1);
+}
+
+// moves the view to pixel position (x, y), clamped to the map, copying in
+// only the rows and columns that come into view: one row or column per 8
+// pixels scrolled, or the whole view for a jump of more than a screen
+void vid_world_scroll(struct vid_world_t *world, uint32_t x, uint32_t y)
+{
+  world_scroll(world, x, y, 0);
+}
+
+// x offsets for lines first..first+count-1, added to the x scroll offset
+// (when enabled) as each line is drawn
+void vid_set_line_scroll_table(uint32_t first, uint32_t count, const uint16_t *offsets)
+{
+  volatile uint32_t *dest = &reg_video_line_scroll[first];
+  while (count--) {
+    *dest++ = *offsets++;
+  }
+}
+
+void vid_enable_line_scroll(uint32_t enable)
+{
+  reg_video_line_scroll_ctrl = enable & 0x01;
 }
 
 void vid_set_x_ofs(uint32_t x)
@@ -93,3 +486,88 @@ void vid_set_y_ofs(uint32_t y)
 {
   reg_video_yofs = y;
 }
+
+void vid_enable_irq(uint32_t mask)
+{
+  reg_video_irq_enable = mask;
+}
+
+// call from irq_handler when IRQ 5 fires, returns the video irqs that were pending
+uint32_t vid_ack_irq()
+{
+  uint32_t pending = reg_video_irq_pending;
+  reg_video_irq_pending = pending;
+  return pending;
+}
+
+// sleeps until the next vblank, needs VID_IRQ_VBLANK enabled and IRQ 5 unmasked
+// the frame counter is checked with every IRQ masked, so a vblank IRQ
+// that comes after the check stays pending and waitirq returns at once;
+// the IRQs are let through between checks so their handlers still run
+void vid_wait_vblank()
+{
+  uint32_t frame = reg_video_frame;
+  uint32_t mask = picorv32_maskirq(0xffffffff);
+  while (reg_video_frame == frame) {
+    picorv32_waitirq();
+    picorv32_maskirq(mask);
+    mask = picorv32_maskirq(0xffffffff);
+  }
+  picorv32_maskirq(mask);
+}
+
+// VID_IRQ_LINE fires as the beam starts this line (0-239)
+void vid_set_line_irq(uint32_t line)
+{
+  reg_video_line_cmp = line;
+}
+
+// returns the line being drawn, or 0 during vblank
+uint32_t vid_get_line()
+{
+  return reg_video_beam & VID_BEAM_LINE;
+}
+
+// scroll and sprite writes go to a shadow bank, which is copied to the
+// display at every vblank unless auto latch is turned off
+void vid_set_auto_latch(uint32_t enable)
+{
+  reg_video_bank_ctrl = enable ? VID_BANK_AUTO_LATCH : 0;
+}
+
+// show everything written so far from the next vblank
+void vid_commit()
+{
+  reg_video_commit = 0;
+}
+
+// show everything written so far straight away (e.g. from a line irq)
+void vid_commit_now()
+{
+  reg_video_commit = 1;
+}
+
+// one bit per sprite, for the frame before the last vblank
+uint32_t vid_get_sprite_collisions()
+{
+  return reg_video_sprite_hits;
+}
+
+uint32_t vid_get_background_collisions()
+{
+  return reg_video_background_hits;
+}
+
+void vid_set_palette(uint32_t index, uint32_t rgb)
+{
+  reg_video_palette[index] = rgb;
+}
+
+// for palette cycling, a run of entries written in one go
+void vid_set_palette_range(uint32_t first, uint32_t count, const uint32_t *rgb)
+{
+  volatile uint32_t *dest = &reg_video_palette[first];
+  for (uint32_t i = 0; i < count; i++) {
+    *dest++ = rgb[i];
+  }
+}
@@ -11,32 +11,202 @@
 #define reg_video_texmem       ((volatile uint32_t*)0x05100000)
 #define reg_video_tilemem      ((volatile uint32_t*)0x05200000)
 #define reg_video_spritemem    ((volatile uint32_t*)0x05300000)
+#define reg_video_texmem_packed    ((volatile uint32_t*)0x05180000)
+#define reg_video_tilemem_packed   ((volatile uint32_t*)0x05280000)
+#define reg_video_spritemem_packed ((volatile uint32_t*)0x05380000)
+#define reg_video_palette      ((volatile uint32_t*)0x05500000)
+#define reg_video_tile_remap   ((volatile uint32_t*)0x05600000)
+#define reg_video_windowmem    ((volatile uint32_t*)0x05700000)
+#define reg_video_windowmem_packed ((volatile uint32_t*)0x05780000)
+#define reg_video_line_scroll  ((volatile uint32_t*)0x05800000)
+#define reg_video_copper_list  ((volatile uint32_t*)0x05900000)
 #define reg_video_xofs        (*(volatile uint32_t*)0x05000000)
 #define reg_video_yofs        (*(volatile uint32_t*)0x05000004)
-#define reg_video_spriteconfig ((volatile uint32_t*)0x05000008)
+#define reg_video_spriteconfig ((volatile uint32_t*)0x05400000)
+#define reg_video_irq_pending (*(volatile uint32_t*)0x05000040)
+#define reg_video_irq_enable  (*(volatile uint32_t*)0x05000044)
+#define reg_video_frame       (*(volatile uint32_t*)0x05000048)
+#define reg_video_line_cmp    (*(volatile uint32_t*)0x0500004c)
+#define reg_video_beam        (*(volatile uint32_t*)0x05000050)
+#define reg_video_bank_ctrl   (*(volatile uint32_t*)0x05000054)
+#define reg_video_commit      (*(volatile uint32_t*)0x05000058)
+#define reg_video_vram_addr   (*(volatile uint32_t*)0x0500005c)
+#define reg_video_vram_data   (*(volatile uint32_t*)0x05000060)
+#define reg_video_sprite_hits (*(volatile uint32_t*)0x05000064)
+#define reg_video_background_hits (*(volatile uint32_t*)0x05000068)
+#define reg_video_remap_ctrl  (*(volatile uint32_t*)0x0500006c)
+#define reg_video_window      (*(volatile uint32_t*)0x05000070)
+#define reg_video_line_scroll_ctrl (*(volatile uint32_t*)0x05000074)
+#define reg_video_tile_page   (*(volatile uint32_t*)0x05000078)
+#define reg_video_tile_fill   (*(volatile uint32_t*)0x0500007c)
+#define reg_video_copper_ctrl (*(volatile uint32_t*)0x05000080)
+#define reg_video_status      (*(volatile uint32_t*)0x05000084)
+
+// video interrupt sources (the video device raises CPU IRQ 5)
+#define VID_IRQ_VBLANK 0x01
+#define VID_IRQ_LINE   0x02
+#define VID_IRQ_SPRITE_OVERFLOW 0x04
+
+// beam position register bits
+#define VID_BEAM_LINE   0x001ff
+#define VID_BEAM_HBLANK 0x10000
+#define VID_BEAM_VBLANK 0x20000
+
+// palette: 0-15 are indexed by texels, 16-31 by sprite colours
+#define VID_PALETTE_SPRITE 16
+#define VID_RGB(r, g, b) ((((r) & 0x3f) << 12) | (((g) & 0x3f) << 6) | ((b) & 0x3f))
+
+// tile remap control bits
+#define VID_REMAP_BANK      0x003
+#define VID_REMAP_LAST_BANK 0x00c
+#define VID_REMAP_AUTO      0x010
+
+// window register bits, or'd with (top << 16) | left
+#define VID_WINDOW_ENABLE   0x80000000
+#define VID_WINDOW_PRIORITY 0x40000000
+
+// tile page register bits
+#define VID_PAGE_MODE   0x01
+#define VID_PAGE_SHOW_1 0x02
+
+// status register bits
+#define VID_STATUS_VBLANK       0x01
+#define VID_STATUS_HBLANK       0x02
+#define VID_STATUS_ACTIVE       0x04
+#define VID_STATUS_COMMIT       0x08
+#define VID_STATUS_ATTR_COPY    0x10
+#define VID_STATUS_TILE_FILL    0x20
+#define VID_STATUS_FILL_DROPPED 0x40
+
+// tile fill status
+#define VID_TILE_FILL_BUSY    0x80000000
+#define VID_TILE_FILL_DROPPED 0x40000000  // a command came while busy (write VID_TILE_FILL_ACK to clear)
+#define VID_TILE_FILL_ACK     0x80000000
+
+// copper display list: each entry is VID_COPPER_WAIT(line, target) then
+// the value, and the list ends with an entry or'd with VID_COPPER_END
+#define VID_COPPER_WAIT(line, target) ((((line) & 0x1ff) << 16) | ((target) & 0xff))
+#define VID_COPPER_END 0x80000000
+#define VID_COPPER_XOFS          0x00
+#define VID_COPPER_YOFS          0x01
+#define VID_COPPER_WINDOW        0x02
+#define VID_COPPER_REMAP         0x03
+#define VID_COPPER_LINE_SCROLL   0x04
+#define VID_COPPER_PALETTE(n)    (0x20 + (n))
+#define VID_COPPER_SPRITE(n)     (0x40 + (n))
+#define VID_COPPER_SPRITE_FLAGS(n) (0x60 + (n))
+
+// register bank control bits
+#define VID_BANK_AUTO_LATCH 0x01
+
+// vram address register: memory select and increment, or'd with the item address
+#define VID_VRAM_TEXTURE   0x000000
+#define VID_VRAM_TILE      0x010000
+#define VID_VRAM_SPRITE    0x020000
+#define VID_VRAM_WINDOW    0x030000
+#define VID_VRAM_STRIDE_64 0x100000
 
 void vid_init();
 
 void vid_set_texture(uint32_t texnum, const uint32_t *data);
 void vid_set_texture_pixel(uint32_t texnum, uint32_t x, uint32_t y, uint32_t pixel);
 void vid_set_tile(uint32_t x, uint32_t y, uint32_t texture);
+uint32_t vid_get_tile(uint32_t x, uint32_t y);
+
+void vid_fill_tile_row(uint32_t x, uint32_t y, uint32_t w, uint32_t texture);
+void vid_copy_tile_row(uint32_t x, uint32_t y, uint32_t w, const uint8_t *tiles);
+// w and h are 0-64 (larger values are clamped to 64, 0 fills nothing); in
+// page mode the rectangle is cut at the bottom of the draw page
+void vid_fill_tile_rect(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint32_t texture);
+void vid_wait_tile_fill();
+void vid_copy_tile_rect(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint8_t *tiles, uint32_t stride);
+
+void vid_set_window(uint32_t x, uint32_t y, uint32_t flags);
+void vid_set_window_tile(uint32_t x, uint32_t y, uint32_t texture);
+void vid_fill_window_row(uint32_t x, uint32_t y, uint32_t w, uint32_t texture);
+void vid_copy_window_row(uint32_t x, uint32_t y, uint32_t w, const uint8_t *tiles);
+
+void vid_set_tile_remap(uint32_t bank, uint32_t tile, uint32_t texture);
+void vid_set_remap_bank(uint32_t bank);
+void vid_set_remap_auto(uint32_t banks, uint32_t vblanks_per_step);
+
+void vid_upload_texture_sheet(const uint8_t *sheet);
+void vid_upload_tilemap(const uint8_t *map, uint32_t width, uint32_t height);
+void vid_upload_sprite(uint32_t image_num, const uint32_t *data);
+void vid_upload_sprite_2bpp(uint32_t image_num, const uint32_t *data);
+
+void vid_set_palette(uint32_t index, uint32_t rgb);
+void vid_set_palette_range(uint32_t first, uint32_t count, const uint32_t *rgb);
+
+void vid_set_line_scroll_table(uint32_t first, uint32_t count, const uint16_t *offsets);
+void vid_enable_line_scroll(uint32_t enable);
+
+void vid_set_copper_list(const uint32_t *list, uint32_t words);
+void vid_enable_copper(uint32_t enable);
+
+void vid_set_page_mode(uint32_t enable);
+void vid_show_page(uint32_t page);
+void vid_set_draw_page(uint32_t page);
+
+// a tile map larger than the 64x64 tile memory, streamed in as it scrolls
+// the map is width x height tiles (one per byte, row by row) and must be at
+// least as big as the screen (40x30 tiles); it needs page mode off, and
+// it uses the whole tile memory whatever vid_set_draw_page() has chosen
+struct vid_world_t {
+  const uint8_t *map;
+  uint32_t width;
+  uint32_t height;
+  uint32_t col;            // top left tile of the view held in tile memory
+  uint32_t row;
+  const uint8_t *row_map;  // start of map row "row"
+};
+
+void vid_world_init(struct vid_world_t *world, const uint8_t *map, uint32_t width, uint32_t height, uint32_t x, uint32_t y);
+void vid_world_scroll(struct vid_world_t *world, uint32_t x, uint32_t y);
 
 void vid_set_x_ofs(uint32_t x);
 void vid_set_y_ofs(uint32_t y);
 
+void vid_enable_irq(uint32_t mask);
+uint32_t vid_ack_irq();
+void vid_wait_vblank();
+void vid_set_line_irq(uint32_t line);
+uint32_t vid_get_line();
+void vid_set_auto_latch(uint32_t enable);
+void vid_commit();
+void vid_commit_now();
+
+uint32_t vid_get_sprite_collisions();
+uint32_t vid_get_background_collisions();
+
+#define VID_NUM_SPRITES 32
+
+// second attribute word of sprite n is reg_video_spriteconfig[VID_NUM_SPRITES + n]
+#define VID_SPRITE_HFLIP   0x01
+#define VID_SPRITE_VFLIP   0x02
+#define VID_SPRITE_2BPP    0x04
+
 struct sprite_config_reg_t {
   uint32_t enable;
   uint32_t colour;
   uint32_t image;
   uint32_t xpos;
   uint32_t ypos;
+  uint32_t flags;    // VID_SPRITE_* bits
+  uint32_t palette;  // 2bpp sprites: palette entries 16 + palette * 4 + 1..3
+  uint32_t frames;   // animation: images shown after the first (0 = still)
+  uint32_t rate;     // animation: extra vblanks each image is shown for
 };
 
 void vid_enable_sprite(uint32_t sprite_num, uint32_t enable);
 void vid_set_image_for_sprite(uint32_t sprite_num, uint32_t image_num);
 void vid_set_sprite_pos(uint32_t sprite_num, uint32_t x, uint32_t y);
 void vid_set_sprite_colour(uint32_t sprite_num, uint32_t sprite_colour);
+void vid_set_sprite_flip(uint32_t sprite_num, uint32_t hflip, uint32_t vflip);
+void vid_set_sprite_2bpp(uint32_t sprite_num, uint32_t enable, uint32_t palette);
+void vid_set_sprite_anim(uint32_t sprite_num, uint32_t frames, uint32_t vblanks_per_frame);
 void vid_set_all_sprite_config(uint32_t sprite_num, struct sprite_config_reg_t *config);
+void vid_get_sprite_config(uint32_t sprite_num, struct sprite_config_reg_t *config);
 void vid_write_sprite_memory(uint32_t image_num, const uint32_t *data);
 void vid_random_init_sprite_memory();
 